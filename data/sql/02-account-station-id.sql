@@ -0,0 +1,10 @@
+-- SWG:ANH Modern - numeric account ids for the login server
+-- The client identifies accounts by a 32-bit station id, and the login
+-- server's session tokens and character lists are keyed by it.
+
+ALTER TABLE account.accounts
+    ADD COLUMN IF NOT EXISTS station_id INTEGER GENERATED BY DEFAULT AS IDENTITY (START WITH 1000) UNIQUE;
+
+-- Bit flags: 1 = CSR, 2 = admin (AccountPermission in the login server)
+ALTER TABLE account.accounts
+    ADD COLUMN IF NOT EXISTS permissions INTEGER NOT NULL DEFAULT 0;
@@ -0,0 +1,26 @@
+-- SWG:ANH Modern - change tracking for login server catch-up
+-- A login server starting from an account snapshot asks for the accounts
+-- changed since the snapshot was taken. Logins (login_count, last_login)
+-- do not count as changes; they are written constantly.
+
+ALTER TABLE account.accounts
+    ADD COLUMN IF NOT EXISTS updated_at TIMESTAMP WITH TIME ZONE NOT NULL DEFAULT NOW();
+
+CREATE INDEX IF NOT EXISTS accounts_updated_at_idx ON account.accounts (updated_at);
+
+CREATE OR REPLACE FUNCTION account.touch_updated_at() RETURNS trigger AS $$
+BEGIN
+    IF NEW.username IS DISTINCT FROM OLD.username
+       OR NEW.password_hash IS DISTINCT FROM OLD.password_hash
+       OR NEW.status IS DISTINCT FROM OLD.status
+       OR NEW.permissions IS DISTINCT FROM OLD.permissions THEN
+        NEW.updated_at := NOW();
+    END IF;
+    RETURN NEW;
+END;
+$$ LANGUAGE plpgsql;
+
+DROP TRIGGER IF EXISTS accounts_touch_updated_at ON account.accounts;
+CREATE TRIGGER accounts_touch_updated_at
+    BEFORE UPDATE ON account.accounts
+    FOR EACH ROW EXECUTE FUNCTION account.touch_updated_at();
@@ -0,0 +1,31 @@
+-- SWG:ANH Modern - station ids leased in blocks
+-- Each login server reserves a block of ids with one UPDATE and hands them
+-- out itself, so several servers can create accounts without colliding and
+-- without a round trip per id. Inserts that leave station_id out (the
+-- website, tools) draw from the same counter one id at a time.
+
+BEGIN;
+
+-- No inserts while the counter is seeded and the default switched over
+LOCK TABLE account.accounts IN EXCLUSIVE MODE;
+
+CREATE TABLE IF NOT EXISTS account.id_blocks (
+    name    TEXT PRIMARY KEY,
+    next_id BIGINT NOT NULL
+);
+
+-- Start past every id already in use
+INSERT INTO account.id_blocks (name, next_id)
+SELECT 'station_id', GREATEST(1000, COALESCE(MAX(station_id) + 1, 1000)) FROM account.accounts
+ON CONFLICT (name) DO NOTHING;
+
+CREATE OR REPLACE FUNCTION account.next_station_id() RETURNS INTEGER AS $$
+    UPDATE account.id_blocks SET next_id = next_id + 1
+    WHERE name = 'station_id'
+    RETURNING (next_id - 1)::integer;
+$$ LANGUAGE sql VOLATILE;
+
+ALTER TABLE account.accounts ALTER COLUMN station_id DROP IDENTITY IF EXISTS;
+ALTER TABLE account.accounts ALTER COLUMN station_id SET DEFAULT account.next_station_id();
+
+COMMIT;
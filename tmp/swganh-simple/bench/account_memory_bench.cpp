@@ -0,0 +1,49 @@
+// File: bench/account_memory_bench.cpp
+// Heap bytes the account table spends per account: name, bcrypt hash,
+// record and index entry. Measured with glibc's mallinfo2 around bulk
+// inserts, so the strings passed in are temporaries and everything the
+// table keeps is counted.
+#include <benchmark/benchmark.h>
+#include <malloc.h>
+#include <string>
+
+#include "../src/core/account_manager.hpp"
+#include "../src/core/logger.hpp"
+#include "../src/core/password_hash.hpp"
+
+using namespace swganh;
+
+namespace {
+
+size_t heap_in_use() {
+    return mallinfo2().uordblks;
+}
+
+void BM_AccountMemory(benchmark::State& state) {
+    init_logger(LogLevel::WARNING_LEVEL);
+    AccountManager& accounts = AccountManager::instance();
+    const size_t count = static_cast<size_t>(state.range(0));
+
+    // Real-looking hashes without a bcrypt per account: vary the digest tail
+    const std::string hash_template = PasswordHash::create("password", PasswordHash::MIN_COST);
+    static size_t run = 0;
+
+    for (auto _ : state) {
+        std::string prefix = "member" + std::to_string(run++) + "_";
+        size_t before = heap_in_use();
+        for (size_t i = 0; i < count; ++i) {
+            std::string hash = hash_template;
+            std::string digits = std::to_string(i);
+            hash.replace(hash.size() - digits.size(), digits.size(), digits);
+            accounts.add_account(prefix + digits, std::move(hash));
+        }
+        size_t after = heap_in_use();
+        state.counters["bytes_per_account"] = static_cast<double>(after - before) / static_cast<double>(count);
+    }
+    state.counters["accounts"] = static_cast<double>(accounts.get_account_count());
+}
+BENCHMARK(BM_AccountMemory)->Arg(100000)->Arg(500000)->Iterations(1)->Unit(benchmark::kMillisecond);
+
+} // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,118 @@
+// File: bench/login_parse_bench.cpp
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+
+#include "../src/core/logger.hpp"
+#include "../src/servers/login/login_messages.hpp"
+#include "../src/servers/login/swg_protocol.hpp"
+
+using namespace swganh;
+
+namespace {
+
+// SOE data header + LoginClientId header followed by the three strings
+std::vector<u8> make_login_packet(const std::string& username, const std::string& password,
+                                  const std::string& version) {
+    std::vector<u8> packet = {0x00, 0x09, 0x00, 0x00, 0x04, 0x00, 0x96, 0x1F, 0x13, 0x41};
+    for (const std::string* field : {&username, &password, &version}) {
+        packet.push_back(static_cast<u8>(field->size() & 0xFF));
+        packet.push_back(static_cast<u8>(field->size() >> 8));
+        packet.insert(packet.end(), field->begin(), field->end());
+    }
+    return packet;
+}
+
+void BM_ParseLoginRequestView(benchmark::State& state) {
+    init_logger(LogLevel::INFO_LEVEL);
+    std::vector<u8> packet = make_login_packet("someusername", "s3cretpassw0rd!", "20050408-18:00");
+
+    for (auto _ : state) {
+        login::LoginRequestView view;
+        bool ok = login::SWGLoginProtocol::parse_login_request_view(packet.data(), packet.size(), view);
+        benchmark::DoNotOptimize(ok);
+        benchmark::DoNotOptimize(view);
+    }
+}
+BENCHMARK(BM_ParseLoginRequestView);
+
+void BM_ParseLoginRequestOwned(benchmark::State& state) {
+    init_logger(LogLevel::INFO_LEVEL);
+    std::vector<u8> packet = make_login_packet("someusername", "s3cretpassw0rd!", "20050408-18:00");
+
+    for (auto _ : state) {
+        login::LoginRequest request = login::SWGLoginProtocol::parse_login_request(packet);
+        benchmark::DoNotOptimize(request);
+    }
+}
+BENCHMARK(BM_ParseLoginRequestOwned);
+
+// Cut off at every length from empty to one byte short, as a lossy link or a
+// scanner would deliver it; all must be rejected
+void BM_ParseLoginRequestTruncated(benchmark::State& state) {
+    init_logger(LogLevel::INFO_LEVEL);
+    std::vector<u8> packet = make_login_packet("someusername", "s3cretpassw0rd!", "20050408-18:00");
+
+    size_t cut = 0;
+    for (auto _ : state) {
+        login::LoginRequestView view;
+        bool ok = login::SWGLoginProtocol::parse_login_request_view(packet.data(), cut, view);
+        benchmark::DoNotOptimize(ok);
+        cut = cut + 1 < packet.size() ? cut + 1 : 0;
+    }
+}
+BENCHMARK(BM_ParseLoginRequestTruncated);
+
+// Length prefixes claiming more than the datagram holds
+void BM_ParseLoginRequestOverlongLength(benchmark::State& state) {
+    init_logger(LogLevel::INFO_LEVEL);
+    std::vector<u8> packet = make_login_packet("someusername", "s3cretpassw0rd!", "20050408-18:00");
+    packet[10] = 0xFF;
+    packet[11] = 0xFF;
+
+    for (auto _ : state) {
+        login::LoginRequestView view;
+        bool ok = login::SWGLoginProtocol::parse_login_request_view(packet.data(), packet.size(), view);
+        benchmark::DoNotOptimize(ok);
+    }
+}
+BENCHMARK(BM_ParseLoginRequestOverlongLength);
+
+// Well-formed strings, but past MAX_LOGIN_STRING
+void BM_ParseLoginRequestOversizedField(benchmark::State& state) {
+    init_logger(LogLevel::INFO_LEVEL);
+    std::vector<u8> packet = make_login_packet(std::string(4000, 'a'), "pw", "20050408-18:00");
+
+    for (auto _ : state) {
+        login::LoginRequestView view;
+        bool ok = login::SWGLoginProtocol::parse_login_request_view(packet.data(), packet.size(), view);
+        benchmark::DoNotOptimize(ok);
+    }
+}
+BENCHMARK(BM_ParseLoginRequestOversizedField);
+
+// A galaxy list whose count promises far more records than the bytes that
+// follow: the decoder must not size its output from the count alone
+void BM_DecodeClusterStatusInflatedCount(benchmark::State& state) {
+    std::vector<u8> packet(1400, 0);
+    packet[0] = 0x02;
+    packet[2] = 0xB6;
+    packet[3] = 0xAE;
+    packet[4] = 0x36;
+    packet[5] = 0x34;
+    // Largest count that still passes a one-byte-per-record sanity check
+    u32 count = static_cast<u32>(packet.size() - 10);
+    packet[6] = static_cast<u8>(count & 0xFF);
+    packet[7] = static_cast<u8>(count >> 8);
+
+    for (auto _ : state) {
+        login::messages::LoginClusterStatus::Values values;
+        bool ok = login::messages::LoginClusterStatus::decode(packet.data(), packet.size(), values);
+        benchmark::DoNotOptimize(ok);
+    }
+}
+BENCHMARK(BM_DecodeClusterStatusInflatedCount);
+
+} // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,187 @@
+// File: bench/message_bench.cpp
+#include <benchmark/benchmark.h>
+#include <array>
+#include <string>
+#include <vector>
+
+#include "../src/servers/login/login_messages.hpp"
+
+using namespace swganh;
+using namespace swganh::login::messages;
+
+namespace {
+
+// The push_back writers the schema replaced, kept as a baseline
+void write_u32_le(std::vector<u8>& data, u32 value) {
+    data.push_back(value & 0xFF);
+    data.push_back((value >> 8) & 0xFF);
+    data.push_back((value >> 16) & 0xFF);
+    data.push_back((value >> 24) & 0xFF);
+}
+
+void write_u16_le(std::vector<u8>& data, u16 value) {
+    data.push_back(value & 0xFF);
+    data.push_back((value >> 8) & 0xFF);
+}
+
+void write_string(std::vector<u8>& data, const std::string& str) {
+    write_u16_le(data, static_cast<u16>(str.length()));
+    data.insert(data.end(), str.begin(), str.end());
+}
+
+const std::array<u8, 32> SESSION_KEY = {};
+
+LoginClientId::Values client_id() {
+    return {"someusername", "s3cretpassw0rd!", "20050408-18:00"};
+}
+
+LoginClientToken::Values client_token() {
+    return {SESSION_KEY, 1000, "someusername"};
+}
+
+LoginEnumCluster::Values enum_cluster(std::size_t galaxies) {
+    LoginEnumCluster::Values values;
+    for (std::size_t i = 0; i < galaxies; ++i) {
+        std::get<0>(values).emplace_back(static_cast<u32>(i + 1), "SWGANH Galaxy", 0);
+    }
+    std::get<1>(values) = 2;
+    return values;
+}
+
+LoginClusterStatus::Values cluster_status(std::size_t galaxies) {
+    LoginClusterStatus::Values values;
+    for (std::size_t i = 0; i < galaxies; ++i) {
+        std::get<0>(values).emplace_back(static_cast<u32>(i + 1), "127.0.0.1", 44464, 44462,
+                                         100, 3000, 2, 0, 2, 0);
+    }
+    return values;
+}
+
+EnumerateCharacterId::Values character_list(std::size_t characters) {
+    EnumerateCharacterId::Values values;
+    for (std::size_t i = 0; i < characters; ++i) {
+        std::get<0>(values).emplace_back(u"Testchar Skywalker", opcode("object/creature/player/shared_human_male.iff"),
+                                         8000000000ULL + i, 1, 1);
+    }
+    return values;
+}
+
+ErrorMessage::Values error_message() {
+    return {"@cpt_login_fail", "Invalid username or password.", 0};
+}
+
+template<typename Msg>
+void encode_bench(benchmark::State& state, const typename Msg::Values& values) {
+    for (auto _ : state) {
+        std::vector<u8> bytes = Msg::encode(values);
+        benchmark::DoNotOptimize(bytes.data());
+    }
+}
+
+template<typename Msg>
+void decode_bench(benchmark::State& state, const typename Msg::Values& values) {
+    std::vector<u8> bytes = Msg::encode(values);
+    for (auto _ : state) {
+        typename Msg::Values decoded;
+        bool ok = Msg::decode(bytes.data(), bytes.size(), decoded);
+        benchmark::DoNotOptimize(ok);
+        benchmark::DoNotOptimize(decoded);
+    }
+}
+
+void BM_Encode_LoginClientId(benchmark::State& state) { encode_bench<LoginClientId>(state, client_id()); }
+void BM_Decode_LoginClientId(benchmark::State& state) { decode_bench<LoginClientId>(state, client_id()); }
+void BM_Encode_LoginClientToken(benchmark::State& state) { encode_bench<LoginClientToken>(state, client_token()); }
+void BM_Decode_LoginClientToken(benchmark::State& state) { decode_bench<LoginClientToken>(state, client_token()); }
+void BM_Encode_ErrorMessage(benchmark::State& state) { encode_bench<ErrorMessage>(state, error_message()); }
+void BM_Decode_ErrorMessage(benchmark::State& state) { decode_bench<ErrorMessage>(state, error_message()); }
+
+void BM_Encode_LoginEnumCluster(benchmark::State& state) {
+    encode_bench<LoginEnumCluster>(state, enum_cluster(static_cast<std::size_t>(state.range(0))));
+}
+
+void BM_Decode_LoginEnumCluster(benchmark::State& state) {
+    decode_bench<LoginEnumCluster>(state, enum_cluster(static_cast<std::size_t>(state.range(0))));
+}
+
+void BM_Encode_LoginClusterStatus(benchmark::State& state) {
+    encode_bench<LoginClusterStatus>(state, cluster_status(static_cast<std::size_t>(state.range(0))));
+}
+
+void BM_Decode_LoginClusterStatus(benchmark::State& state) {
+    decode_bench<LoginClusterStatus>(state, cluster_status(static_cast<std::size_t>(state.range(0))));
+}
+
+void BM_Encode_EnumerateCharacterId(benchmark::State& state) {
+    encode_bench<EnumerateCharacterId>(state, character_list(static_cast<std::size_t>(state.range(0))));
+}
+
+void BM_Decode_EnumerateCharacterId(benchmark::State& state) {
+    decode_bench<EnumerateCharacterId>(state, character_list(static_cast<std::size_t>(state.range(0))));
+}
+
+// LoginClusterStatus/1 built the way the protocol code used to, for comparison
+void BM_PushBack_LoginClusterStatus(benchmark::State& state) {
+    const std::string address = "127.0.0.1";
+    for (auto _ : state) {
+        std::vector<u8> response;
+        write_u16_le(response, 2);
+        write_u32_le(response, LoginClusterStatus::opcode);
+        write_u32_le(response, 1);
+        write_u32_le(response, 1);
+        write_string(response, address);
+        write_u16_le(response, 44464);
+        write_u16_le(response, 44462);
+        write_u32_le(response, 100);
+        write_u32_le(response, 3000);
+        write_u32_le(response, 2);
+        write_u32_le(response, 0);
+        write_u32_le(response, 2);
+        response.push_back(0);
+        benchmark::DoNotOptimize(response.data());
+    }
+}
+
+using Route = int (*)();
+
+int route_a() { return 1; }
+int route_b() { return 2; }
+
+constexpr auto ROUTES = make_opcode_router<Route>(
+    OpcodeRoute<Route>{LoginClientId::opcode, &route_a},
+    OpcodeRoute<Route>{LoginClientToken::opcode, &route_b},
+    OpcodeRoute<Route>{LoginEnumCluster::opcode, &route_a},
+    OpcodeRoute<Route>{LoginClusterStatus::opcode, &route_b},
+    OpcodeRoute<Route>{ErrorMessage::opcode, &route_a}
+);
+
+// Inbound opcode -> handler, alternating hits and a miss
+void BM_RouteOpcode(benchmark::State& state) {
+    const u32 opcodes[] = {LoginClientId::opcode, ErrorMessage::opcode, 0xDEADBEEF, LoginClusterStatus::opcode};
+    std::size_t i = 0;
+    for (auto _ : state) {
+        u32 code = opcodes[i++ & 3];
+        benchmark::DoNotOptimize(code);
+        Route route = ROUTES.find(code);
+        benchmark::DoNotOptimize(route);
+    }
+}
+
+BENCHMARK(BM_Encode_LoginClientId);
+BENCHMARK(BM_Decode_LoginClientId);
+BENCHMARK(BM_Encode_LoginClientToken);
+BENCHMARK(BM_Decode_LoginClientToken);
+BENCHMARK(BM_Encode_LoginEnumCluster)->Arg(1)->Arg(20);
+BENCHMARK(BM_Decode_LoginEnumCluster)->Arg(1)->Arg(20);
+BENCHMARK(BM_Encode_LoginClusterStatus)->Arg(1)->Arg(20);
+BENCHMARK(BM_Decode_LoginClusterStatus)->Arg(1)->Arg(20);
+BENCHMARK(BM_Encode_EnumerateCharacterId)->Arg(2)->Arg(8);
+BENCHMARK(BM_Decode_EnumerateCharacterId)->Arg(2)->Arg(8);
+BENCHMARK(BM_Encode_ErrorMessage);
+BENCHMARK(BM_Decode_ErrorMessage);
+BENCHMARK(BM_PushBack_LoginClusterStatus);
+BENCHMARK(BM_RouteOpcode);
+
+} // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,34 @@
+// File: bench/password_hash_bench.cpp
+// Cost of one bcrypt verification per cost factor; multiply by auth_workers
+// to get the logins per second a node can absorb.
+#include <benchmark/benchmark.h>
+#include <string>
+
+#include "../src/core/password_hash.hpp"
+
+using namespace swganh;
+
+namespace {
+
+void BM_VerifyPassword(benchmark::State& state) {
+    std::string hash = PasswordHash::create("s3cretpassw0rd!", static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        bool ok = PasswordHash::verify("s3cretpassw0rd!", hash);
+        benchmark::DoNotOptimize(ok);
+    }
+}
+BENCHMARK(BM_VerifyPassword)->DenseRange(8, 12, 2)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// Malformed stored hashes are rejected without hashing
+void BM_VerifyMalformedHash(benchmark::State& state) {
+    std::string hash = "not-a-bcrypt-hash";
+    for (auto _ : state) {
+        bool ok = PasswordHash::verify("s3cretpassw0rd!", hash);
+        benchmark::DoNotOptimize(ok);
+    }
+}
+BENCHMARK(BM_VerifyMalformedHash);
+
+} // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,49 @@
+// File: bench/session_token_bench.cpp
+#include <benchmark/benchmark.h>
+
+#include "../src/core/logger.hpp"
+#include "../src/core/session_token.hpp"
+
+using namespace swganh;
+
+namespace {
+
+SessionTokens& tokens() {
+    init_logger(LogLevel::ERROR_LEVEL);
+    return SessionTokens::instance();
+}
+
+void BM_IssueToken(benchmark::State& state) {
+    SessionTokens& signer = tokens();
+    for (auto _ : state) {
+        SessionTokens::Token token = signer.issue(1000, 0);
+        benchmark::DoNotOptimize(token);
+    }
+}
+BENCHMARK(BM_IssueToken);
+
+// What a zone server pays per connecting client
+void BM_VerifyToken(benchmark::State& state) {
+    SessionTokens& signer = tokens();
+    SessionTokens::Token token = signer.issue(1000, 0);
+    for (auto _ : state) {
+        auto claims = signer.verify(token);
+        benchmark::DoNotOptimize(claims);
+    }
+}
+BENCHMARK(BM_VerifyToken);
+
+void BM_VerifyForgedToken(benchmark::State& state) {
+    SessionTokens& signer = tokens();
+    SessionTokens::Token token = signer.issue(1000, 0);
+    token[6] ^= 0x02;  // Try to grant ourselves admin
+    for (auto _ : state) {
+        auto claims = signer.verify(token);
+        benchmark::DoNotOptimize(claims);
+    }
+}
+BENCHMARK(BM_VerifyForgedToken);
+
+} // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,46 @@
+// File: fuzz/replay_main.cpp
+// Stand-in for libFuzzer's main on compilers without -fsanitize=fuzzer: runs
+// each file (or each file in each directory) given on the command line through
+// LLVMFuzzerTestOneInput once. Good for replaying the corpus and crash
+// reproducers under the sanitizers; it does not mutate anything.
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+
+namespace {
+
+bool run_file(const std::filesystem::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::fprintf(stderr, "cannot read %s\n", path.c_str());
+        return false;
+    }
+    std::vector<uint8_t> input((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    LLVMFuzzerTestOneInput(input.data(), input.size());
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t inputs = 0;
+    for (int i = 1; i < argc; ++i) {
+        std::filesystem::path path(argv[i]);
+        if (std::filesystem::is_directory(path)) {
+            for (const auto& entry : std::filesystem::directory_iterator(path)) {
+                if (entry.is_regular_file() && run_file(entry.path())) ++inputs;
+            }
+        } else if (run_file(path)) {
+            ++inputs;
+        }
+    }
+
+    std::printf("Executed %zu inputs\n", inputs);
+    return 0;
+}
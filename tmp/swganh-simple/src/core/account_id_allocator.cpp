@@ -0,0 +1,69 @@
+// File: src/core/account_id_allocator.cpp
+#include "account_id_allocator.hpp"
+#include "logger.hpp"
+
+#include <algorithm>
+
+namespace swganh {
+
+AccountIdAllocator::AccountIdAllocator(u32 block_size)
+    : block_size_(std::max<u32>(block_size, 1)) {
+}
+
+void AccountIdAllocator::set_store(std::shared_ptr<AccountStore> store) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    store_ = std::move(store);
+    if (store_) {
+        next_ = end_ = 0;
+    } else {
+        next_ = FIRST_LOCAL_ID;
+        end_ = 0xFFFFFFFFu;
+    }
+}
+
+u32 AccountIdAllocator::next() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (next_ == end_) {
+        if (!store_) throw AccountStoreError("account ids exhausted");
+        IdBlock block;
+        try {
+            block = store_->lease_account_ids(block_size_);
+        } catch (const AccountStoreError&) {
+            ++failures_;
+            throw;
+        }
+        // Id 0 means "none" everywhere, and a block must not wrap
+        if (block.first == 0 || block.count == 0 || block.first > 0xFFFFFFFFu - block.count) {
+            ++failures_;
+            throw AccountStoreError("account id lease returned an invalid block");
+        }
+        next_ = block.first;
+        end_ = block.first + block.count;
+        ++blocks_;
+        LOG_DEBUG_F("Leased account ids {}-{}", block.first, end_ - 1);
+    }
+    ++issued_;
+    return next_++;
+}
+
+AccountIdAllocatorStats AccountIdAllocator::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    AccountIdAllocatorStats s;
+    s.issued = issued_;
+    s.blocks = blocks_;
+    s.failures = failures_;
+    s.remaining = end_ - next_;
+    return s;
+}
+
+void AccountIdAllocator::log_stats() const {
+    AccountIdAllocatorStats s = stats();
+    if (s.blocks == 0 && s.failures == 0) {
+        LOG_INFO_F("Account ids: {} issued locally", s.issued);
+        return;
+    }
+    LOG_INFO_F("Account ids: {} issued from {} leased blocks, {} left, {} failed leases",
+               s.issued, s.blocks, s.remaining, s.failures);
+}
+
+} // namespace swganh
@@ -0,0 +1,56 @@
+// File: src/core/account_id_allocator.hpp
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include "types.hpp"
+#include "account_store.hpp"
+
+namespace swganh {
+
+struct AccountIdAllocatorStats {
+    u64 issued = 0;      // Ids handed out
+    u64 blocks = 0;      // Blocks leased from the store
+    u64 failures = 0;    // Leases that threw
+    u32 remaining = 0;   // Left in the current block
+};
+
+// Account ids for new accounts. With a store, ids come from blocks leased
+// atomically from it, so any number of login servers sharing the database
+// hand out disjoint ids, and only one id in block_size costs a round trip.
+// Ids left in a block when the process exits are never used; the id space
+// is 2^31 and blocks are small, so gaps are cheap.
+//
+// Without a store the process is the only writer and counts up locally
+// from FIRST_LOCAL_ID.
+class AccountIdAllocator {
+public:
+    static constexpr u32 FIRST_LOCAL_ID = 1000;
+
+    explicit AccountIdAllocator(u32 block_size);
+
+    // Drops the current block; ids are leased from store from now on
+    void set_store(std::shared_ptr<AccountStore> store);
+
+    // Thread safe. Throws AccountStoreError if a block was needed and could
+    // not be leased; the next call tries again.
+    u32 next();
+
+    AccountIdAllocatorStats stats() const;
+    void log_stats() const;
+
+private:
+    // A lease holds the lock for one round trip; creators behind it wait
+    // for the same block instead of leasing their own
+    mutable std::mutex mutex_;
+    std::shared_ptr<AccountStore> store_;
+    u32 block_size_;
+    u32 next_ = FIRST_LOCAL_ID;
+    u32 end_ = 0xFFFFFFFFu;  // Exclusive
+
+    u64 issued_ = 0;
+    u64 blocks_ = 0;
+    u64 failures_ = 0;
+};
+
+} // namespace swganh
@@ -0,0 +1,99 @@
+// File: src/core/account_id_allocator_test.cpp
+#include "account_id_allocator.hpp"
+#include "fake_account_store.hpp"
+
+#include <gtest/gtest.h>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace swganh {
+namespace {
+
+using AccountIdAllocatorTest = testing::FakeAccountStoreTest;
+
+TEST_F(AccountIdAllocatorTest, TwoServersSharingAStoreNeverCollide) {
+    AccountIdAllocator first(7);
+    AccountIdAllocator second(7);
+    first.set_store(store_);
+    second.set_store(store_);
+
+    std::vector<std::vector<u32>> issued(4);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < issued.size(); ++t) {
+        AccountIdAllocator& allocator = t % 2 ? first : second;
+        threads.emplace_back([&allocator, &ids = issued[t]] {
+            for (int i = 0; i < 5000; ++i) ids.push_back(allocator.next());
+        });
+    }
+    for (std::thread& thread : threads) thread.join();
+
+    std::set<u32> unique;
+    for (const auto& ids : issued) unique.insert(ids.begin(), ids.end());
+    EXPECT_EQ(unique.size(), 20000u);
+    EXPECT_EQ(*unique.begin(), 1000u);
+
+    // One lease per block, not per id
+    AccountIdAllocatorStats a = first.stats();
+    AccountIdAllocatorStats b = second.stats();
+    EXPECT_EQ(a.issued + b.issued, 20000u);
+    EXPECT_EQ(static_cast<u64>(store_->leases()), a.blocks + b.blocks);
+    EXPECT_LE(a.blocks + b.blocks, 20000u / 7 + 2);
+}
+
+TEST_F(AccountIdAllocatorTest, IdsWithinABlockAreConsecutive) {
+    AccountIdAllocator allocator(3);
+    allocator.set_store(store_);
+    EXPECT_EQ(allocator.next(), 1000u);
+    EXPECT_EQ(allocator.next(), 1001u);
+    EXPECT_EQ(allocator.stats().remaining, 1u);
+    EXPECT_EQ(allocator.next(), 1002u);
+    EXPECT_EQ(allocator.next(), 1003u);
+    EXPECT_EQ(store_->leases(), 2);
+}
+
+TEST_F(AccountIdAllocatorTest, FailedLeaseThrowsAndTheNextCallRetries) {
+    AccountIdAllocator allocator(3);
+    allocator.set_store(store_);
+    store_->set_down(true);
+    EXPECT_THROW(allocator.next(), AccountStoreError);
+    EXPECT_EQ(allocator.stats().failures, 1u);
+
+    store_->set_down(false);
+    EXPECT_EQ(allocator.next(), 1000u);
+}
+
+TEST_F(AccountIdAllocatorTest, InvalidBlocksAreRejected) {
+    AccountIdAllocator allocator(3);
+    allocator.set_store(store_);
+
+    store_->set_next_block(IdBlock{0, 3});
+    EXPECT_THROW(allocator.next(), AccountStoreError);
+    store_->set_next_block(IdBlock{5000, 0});
+    EXPECT_THROW(allocator.next(), AccountStoreError);
+    store_->set_next_block(IdBlock{0xFFFFFFF0u, 0x20});
+    EXPECT_THROW(allocator.next(), AccountStoreError);
+    EXPECT_EQ(allocator.stats().failures, 3u);
+
+    EXPECT_EQ(allocator.next(), 1000u);
+}
+
+TEST_F(AccountIdAllocatorTest, WithoutAStoreIdsCountUpLocally) {
+    AccountIdAllocator allocator(100);
+    EXPECT_EQ(allocator.next(), AccountIdAllocator::FIRST_LOCAL_ID);
+    EXPECT_EQ(allocator.next(), AccountIdAllocator::FIRST_LOCAL_ID + 1);
+    EXPECT_EQ(allocator.stats().blocks, 0u);
+}
+
+TEST_F(AccountIdAllocatorTest, SettingAStoreDropsTheLocalCount) {
+    AccountIdAllocator allocator(10);
+    allocator.next();
+    allocator.next();
+
+    store_->set_next_block(IdBlock{50000, 10});
+    allocator.set_store(store_);
+    EXPECT_EQ(allocator.next(), 50000u);
+}
+
+} // namespace
+} // namespace swganh
@@ -2,16 +2,402 @@
 #include "account_manager.hpp"
 #include "config.hpp"
 #include "logger.hpp"
+#include "password_hash.hpp"
+
+#include <algorithm>
 
 namespace swganh {
 
-LoginResult AccountManager::try_auto_create_account(const std::string& username, const std::string& password) {
+namespace {
+
+int bcrypt_cost() {
+    return Config::instance().get_int("bcrypt_cost", 10);
+}
+
+// Catch-up reads back this far before the last as_of, covering clock skew
+// between nodes and the database and transactions that committed late
+constexpr i64 CATCH_UP_OVERLAP = 60;
+
+i64 unix_now() {
+    return std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+AccountManager::AccountManager()
+    : credentials_(std::chrono::seconds(Config::instance().get_int("credential_cache_ttl", 180)),
+                   static_cast<size_t>(Config::instance().get_int("credential_cache_size", 100000))),
+      account_ids_(static_cast<u32>(Config::instance().get_int("account_id_block_size", 100))) {
+}
+
+LoginResult AccountManager::authenticate(std::string_view username, std::string_view password) {
+    Account* account;
+    try {
+        // Random names from credential stuffing stop here, unlogged
+        if (!username_may_exist(username)) {
+            filtered_unknown_.fetch_add(1, std::memory_order_relaxed);
+            if (!Config::instance().get_bool("auto_create_accounts")) {
+                return LoginResult::INVALID_CREDENTIALS;
+            }
+            return try_auto_create_account(username, password);
+        }
+        account = find_or_load(username);
+        if (!account) {
+            if (username_filter_.load(std::memory_order_relaxed)) {
+                filter_false_positive_.fetch_add(1, std::memory_order_relaxed);
+            }
+            // Account doesn't exist - check if we should auto-create
+            return try_auto_create_account(username, password);
+        }
+    } catch (const AccountStoreError& e) {
+        LOG_ERROR_F("Account store unavailable: {}", e.what());
+        return LoginResult::MAINTENANCE;
+    } catch (const std::exception& e) {
+        // Hashing a new account's password failed
+        LOG_ERROR_F("Login for '{}' failed: {}", username, e.what());
+        return LoginResult::MAINTENANCE;
+    }
+    
+    // The bytes are never freed; only which ones the record points at changes
+    std::string_view password_hash;
+    {
+        std::lock_guard<std::mutex> lock(shard_for(username).mutex);
+        password_hash = account->password_hash;
+    }
+    u32 account_id = account->account_id;
+    
+    // A reconnect within the TTL skips bcrypt; otherwise the expensive part,
+    // with the table unlocked
+    if (!credentials_.check(account_id, password, password_hash)) {
+        if (!PasswordHash::verify(password, std::string(password_hash))) {
+            return LoginResult::INVALID_CREDENTIALS;
+        }
+        credentials_.remember(account_id, password, password_hash);
+    }
+    if (!account->is_active.load(std::memory_order_relaxed)) {
+        return LoginResult::ACCOUNT_DISABLED;
+    }
+    
+    record_login(*account);
+    return LoginResult::SUCCESS;
+}
+
+void AccountManager::set_store(std::shared_ptr<AccountStore> store) {
+    Config& config = Config::instance();
+    login_stats_.reset();
+    store_ = std::move(store);
+    account_ids_.set_store(store_);
+    if (store_) {
+        login_stats_ = std::make_unique<LoginStatsWriter>(
+            store_, std::chrono::milliseconds(config.get_int("login_stats_flush_ms", 5000)),
+            static_cast<size_t>(config.get_int("login_stats_batch_size", 1000)),
+            std::chrono::milliseconds(config.get_int("login_stats_shutdown_ms", 10000)));
+        // Records loaded from now on are as new as this
+        catch_up_since_.store(unix_now() - CATCH_UP_OVERLAP);
+    }
+}
+
+bool AccountManager::load_snapshot(const std::string& path) {
+    auto started = std::chrono::steady_clock::now();
+    snapshot_ = AccountSnapshot::open(path);
+    if (!snapshot_) return false;
+    catch_up_since_.store(snapshot_->as_of() - CATCH_UP_OVERLAP);
+    
+    auto took = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - started);
+    LOG_INFO_F("Account snapshot '{}': {} accounts, {} s old, mapped in {} us", path, snapshot_->size(),
+               unix_now() - snapshot_->as_of(), took.count());
+    return true;
+}
+
+bool AccountManager::catch_up() {
+    if (!store_) return true;
+    if (catch_up_running_.exchange(true)) return true;
+    
+    i64 since = catch_up_since_.load();
+    size_t seen = 0;
+    size_t changed = 0;
+    try {
+        i64 as_of = store_->scan_changed_since(since, [&](const StoredAccount& stored) {
+            ++seen;
+            // Names created elsewhere reach the filter whether or not this
+            // node keeps the record
+            note_username(stored.username);
+            if (apply_change(stored)) ++changed;
+        });
+        catch_up_since_.store(as_of - CATCH_UP_OVERLAP);
+    } catch (const AccountStoreError& e) {
+        LOG_ERROR_F("Account catch-up failed: {}", e.what());
+        catch_up_running_.store(false);
+        return false;
+    }
+    catch_up_changes_.fetch_add(changed, std::memory_order_relaxed);
+    caught_up_.store(true);
+    catch_up_running_.store(false);
+    
+    if (changed > 0) LOG_INFO_F("Account catch-up: {} changed rows, {} records updated", seen, changed);
+    return true;
+}
+
+bool AccountManager::apply_change(const StoredAccount& stored) {
+    Account* account = pool_.find(stored.account_id);
+    bool changed = false;
+    if (!account) {
+        // Not in memory: the store serves it fresh on demand, unless the
+        // snapshot would answer first with the old row
+        if (!snapshot_) return false;
+        account = insert_stored(stored);
+        changed = true;
+    }
+    if (account->username != stored.username) {
+        LOG_WARNING_F("Account {} renamed from '{}' to '{}'; restart to pick up the new name",
+                      stored.account_id, account->username, stored.username);
+        return false;
+    }
+    
+    bool credentials_changed = false;
+    {
+        std::lock_guard<std::mutex> lock(shard_for(account->username).mutex);
+        if (account->password_hash != stored.password_hash) {
+            account->password_hash = pool_.intern(stored.password_hash);
+            credentials_changed = true;
+        }
+        if (account->is_active.load(std::memory_order_relaxed) != stored.is_active) {
+            account->is_active.store(stored.is_active, std::memory_order_relaxed);
+            credentials_changed = true;
+        }
+        if (account->permissions.load(std::memory_order_relaxed) != stored.permissions) {
+            account->permissions.store(stored.permissions, std::memory_order_relaxed);
+            changed = true;
+        }
+    }
+    if (credentials_changed) credentials_.invalidate(account->account_id);
+    return changed || credentials_changed;
+}
+
+bool AccountManager::write_snapshot(const std::string& path) {
+    if (!store_) return false;
+    
+    auto started = std::chrono::steady_clock::now();
+    AccountSnapshot::Writer writer;
+    i64 as_of;
+    try {
+        as_of = store_->scan_changed_since(0, [&](const StoredAccount& stored) { writer.add(stored); });
+    } catch (const AccountStoreError& e) {
+        LOG_ERROR_F("Account snapshot not written: {}", e.what());
+        return false;
+    }
+    if (!writer.finish(path, as_of)) return false;
+    
+    auto took = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - started);
+    LOG_INFO_F("Account snapshot '{}' written: {} accounts in {} ms", path, writer.size(), took.count());
+    return true;
+}
+
+void AccountManager::flush_login_stats() {
+    if (login_stats_) login_stats_->stop();
+}
+
+bool AccountManager::rebuild_username_filter() {
+    if (rebuild_running_.exchange(true)) return true;
+    
+    Config& config = Config::instance();
+    size_t capacity = static_cast<size_t>(config.get_int("username_filter_capacity", 1000000));
+    size_t expected = std::max(capacity, get_account_count() * 2);
+    auto filter = std::make_shared<BloomFilter>(expected);
+    
+    // Names created from here on go into the new filter as well
+    rebuilding_filter_.store(filter);
+    size_t names = 0;
+    if (snapshot_ && caught_up_.load() && !username_filter_.load()) {
+        // Caught up, every name missing from the snapshot is in a shard
+        snapshot_->for_each_username([&](std::string_view username) {
+            filter->insert(username);
+            ++names;
+        });
+    } else if (store_) {
+        try {
+            store_->scan_usernames([&](std::string_view username) {
+                filter->insert(username);
+                ++names;
+            });
+        } catch (const AccountStoreError& e) {
+            LOG_ERROR_F("Username filter not rebuilt: {}", e.what());
+            rebuilding_filter_.store(nullptr);
+            rebuild_running_.store(false);
+            return false;
+        }
+    }
+    for (Shard& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for (const auto& [username, account] : shard.accounts) {
+            filter->insert(username);
+        }
+    }
+    username_filter_.store(filter, std::memory_order_release);
+    rebuilding_filter_.store(nullptr);
+    rebuild_running_.store(false);
+    
+    if (names > expected) {
+        LOG_WARNING_F("Username filter sized for {} names holds {}; raise username_filter_capacity",
+                      expected, names);
+    }
+    LOG_INFO_F("Username filter rebuilt: {} stored names, {} KiB", names, filter->size_bytes() / 1024);
+    return true;
+}
+
+void AccountManager::note_username(std::string_view username) {
+    if (auto filter = username_filter_.load(std::memory_order_acquire)) filter->insert(username);
+    if (auto filter = rebuilding_filter_.load()) filter->insert(username);
+}
+
+void AccountManager::log_stats() const {
+    LOG_INFO_F("Accounts: {} in memory, {} KiB of records and strings", get_account_count(),
+               memory_reserved() / 1024);
+    account_ids_.log_stats();
+    credentials_.log_stats();
+    if (login_stats_) login_stats_->log_stats();
+    LOG_INFO_F("Username filter: {} unknown names rejected, {} false positives",
+               filtered_unknown_.load(std::memory_order_relaxed),
+               filter_false_positive_.load(std::memory_order_relaxed));
+    if (snapshot_) {
+        LOG_INFO_F("Account snapshot: {} accounts, {} loaded from it, {} records updated by catch-up",
+                   snapshot_->size(), snapshot_hits_.load(std::memory_order_relaxed),
+                   catch_up_changes_.load(std::memory_order_relaxed));
+    }
+    if (store_) store_->log_stats();
+}
+
+void AccountManager::record_login(Account& account) {
+    i64 now = unix_now();
+    account.login_count.fetch_add(1, std::memory_order_relaxed);
+    account.last_login.store(now, std::memory_order_relaxed);
+    if (login_stats_) login_stats_->record(account.account_id, now);
+}
+
+void AccountManager::create_test_accounts() {
+    int cost = bcrypt_cost();
+    std::string test_hash = PasswordHash::create("test", cost);
+    std::string admin_hash = PasswordHash::create("admin", cost);
+    std::string dev_hash = PasswordHash::create("dev", cost);
+    
+    add_account("test", test_hash);
+    add_account("admin", admin_hash);
+    get_account("admin")->permissions.store(PERMISSION_ADMIN | PERMISSION_CSR, std::memory_order_relaxed);
+    add_account("dev", dev_hash);
+}
+
+Account* AccountManager::find_or_load(std::string_view username) {
+    if (auto account = get_account(username)) return account;
+    if (snapshot_) {
+        if (std::optional<StoredAccount> stored = snapshot_->find(username)) {
+            snapshot_hits_.fetch_add(1, std::memory_order_relaxed);
+            return insert_stored(*stored);
+        }
+    }
+    if (!store_) return nullptr;
+    
+    std::optional<StoredAccount> stored = store_->find_account(username);
+    return stored ? insert_stored(*stored) : nullptr;
+}
+
+Account* AccountManager::insert_stored(const StoredAccount& stored) {
+    // Checked under the lock so a losing racer never allocates a record
+    Shard& shard = shard_for(stored.username);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.accounts.find(std::string_view(stored.username));
+    if (it != shard.accounts.end()) return it->second;
+    
+    Account* account = pool_.create(stored.account_id, stored.username, stored.password_hash);
+    account->is_active.store(stored.is_active, std::memory_order_relaxed);
+    account->login_count.store(stored.login_count, std::memory_order_relaxed);
+    account->permissions.store(stored.permissions, std::memory_order_relaxed);
+    shard.accounts.emplace(account->username, account);
+    account_count_.fetch_add(1, std::memory_order_relaxed);
+    note_username(stored.username);
+    return account;
+}
+
+u32 AccountManager::add_account(std::string_view username, std::string_view password_hash) {
+    Shard& shard = shard_for(username);
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (shard.accounts.find(username) != shard.accounts.end()) return 0;
+    }
+    // Leasing may take a round trip, so not under the lock; a racing add
+    // of the same name wastes the id
+    u32 new_id = account_ids_.next();
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (shard.accounts.find(username) != shard.accounts.end()) return 0;
+    return create_account(shard, new_id, username, password_hash);
+}
+
+bool AccountManager::set_password(std::string_view username, std::string_view password) {
+    std::string password_hash;
+    try {
+        password_hash = PasswordHash::create(password, bcrypt_cost());
+    } catch (const std::exception& e) {
+        LOG_ERROR_F("Password for '{}' not changed: {}", username, e.what());
+        return false;
+    }
+    
+    u32 account_id;
+    {
+        Shard& shard = shard_for(username);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.accounts.find(username);
+        if (it == shard.accounts.end()) return false;
+        it->second->password_hash = pool_.intern(password_hash);
+        account_id = it->second->account_id;
+    }
+    credentials_.invalidate(account_id);
+    return true;
+}
+
+bool AccountManager::set_active(std::string_view username, bool active) {
+    u32 account_id;
+    {
+        Shard& shard = shard_for(username);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.accounts.find(username);
+        if (it == shard.accounts.end()) return false;
+        it->second->is_active.store(active, std::memory_order_relaxed);
+        account_id = it->second->account_id;
+    }
+    credentials_.invalidate(account_id);
+    return true;
+}
+
+// Called with no locks held; throws AccountStoreError
+LoginResult AccountManager::try_auto_create_account(std::string_view username, std::string_view password) {
     Config& config = Config::instance();
     
     if (config.get_bool("auto_create_accounts")) {
         LOG_INFO_F("Auto-creating account for user: {}", username);
         
-        u32 new_id = create_account(username, password);
+        if (password.find('\0') != std::string_view::npos) {
+            return LoginResult::INVALID_CREDENTIALS;
+        }
+        std::string password_hash = PasswordHash::create(password, bcrypt_cost());
+        
+        // If another login created the same name meanwhile, authenticate
+        // against that account instead; it exists now, so this recurses once
+        u32 new_id;
+        if (store_) {
+            // From this server's leased block; no other server has it
+            new_id = account_ids_.next();
+            if (!store_->create_account(new_id, username, password_hash)) {
+                // Created elsewhere since the filter was built; it exists now
+                note_username(username);
+                return authenticate(username, password);
+            }
+            record_login(*insert_stored(StoredAccount{new_id, std::string(username), password_hash, true, 0,
+                                                      PERMISSION_PLAYER}));
+        } else {
+            new_id = add_account(username, password_hash);
+            if (new_id == 0) return authenticate(username, password);
+            if (auto account = get_account(username)) record_login(*account);
+        }
         
         LOG_INFO_F("Created account ID {} for user '{}' (development mode)", new_id, username);
         return LoginResult::SUCCESS;
@@ -22,4 +408,4 @@ LoginResult AccountManager::try_auto_create_account(const std::string& username,
     }
 }
 
-} // namespace swganh
\ No newline at end of file
+} // namespace swganh
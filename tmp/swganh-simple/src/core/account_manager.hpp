@@ -1,24 +1,28 @@
 // File: src/core/account_manager.hpp
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <memory>
+#include <mutex>
 #include "types.hpp"
+#include "credential_cache.hpp"
+#include "account_store.hpp"
+#include "bloom_filter.hpp"
+#include "login_stats_writer.hpp"
+#include "account_pool.hpp"
+#include "account_snapshot.hpp"
+#include "account_id_allocator.hpp"
 
 namespace swganh {
 
-struct Account {
-    u32 account_id;
-    std::string username;
-    std::string password;
-    bool is_active;
-    std::string created_date;
-    u32 login_count;
-    
-    Account(u32 id, const std::string& user, const std::string& pass) 
-        : account_id(id), username(user), password(pass), is_active(true), 
-          created_date("2025-09-12"), login_count(0) {}
+// Lets the account map be searched by string_view without building a key
+struct StringHash {
+    using is_transparent = void;
+    size_t operator()(std::string_view value) const { return std::hash<std::string_view>{}(value); }
 };
 
 enum class LoginResult {
@@ -36,57 +40,162 @@ public:
         return inst;
     }
     
-    LoginResult authenticate(const std::string& username, const std::string& password) {
-        auto it = accounts_.find(username);
-        
-        if (it != accounts_.end()) {
-            // Account exists - check password
-            if (it->second->password == password) {
-                if (it->second->is_active) {
-                    it->second->login_count++;
-                    return LoginResult::SUCCESS;
-                } else {
-                    return LoginResult::ACCOUNT_DISABLED;
-                }
-            } else {
-                return LoginResult::INVALID_CREDENTIALS;
-            }
-        } else {
-            // Account doesn't exist - check if we should auto-create
-            return try_auto_create_account(username, password);
-        }
-    }
+    // Safe to call from any thread. Verifies the bcrypt hash, so it takes
+    // milliseconds: run it on the auth pool. The table lock is not held while
+    // hashing or while the store is queried. MAINTENANCE if the store or
+    // hashing fails; it does not throw.
+    LoginResult authenticate(std::string_view username, std::string_view password);
     
-    std::shared_ptr<Account> get_account(const std::string& username) {
-        auto it = accounts_.find(username);
-        return (it != accounts_.end()) ? it->second : nullptr;
-    }
+    // Back the in-memory table with a durable store: misses are loaded from
+    // it, auto-created accounts are written to it and login statistics are
+    // written behind in batches. Set before serving.
+    void set_store(std::shared_ptr<AccountStore> store);
+    
+    // Writes the pending login statistics; call once logins have stopped
+    void flush_login_stats();
+    
+    // Answer lookups from a snapshot file (see write_snapshot) before going
+    // to the store, so logins are served as soon as the file is mapped.
+    // Call after set_store, before serving. Until catch_up has run, accounts
+    // changed since the snapshot was written are served as they were then.
+    // False if the file is missing or invalid; lookups then use the store.
+    bool load_snapshot(const std::string& path);
+    
+    // Applies accounts the store changed since the snapshot or the previous
+    // catch-up (password, ban, permissions) to the records in memory, and
+    // loads changed ones the snapshot would otherwise serve stale. Run it on
+    // the auth pool; a second call while one runs returns at once. False if
+    // the store could not be read.
+    bool catch_up();
+    
+    // Writes every stored account to path for the next start. A full table
+    // scan, so run it on the auth pool. False on failure (logged).
+    bool write_snapshot(const std::string& path);
+    
+    // Unix seconds the loaded snapshot was taken at, 0 without one
+    i64 snapshot_as_of() const { return snapshot_ ? snapshot_->as_of() : 0; }
+    
+    // Rebuilds the filter of known usernames from the store (when there is
+    // one) and the in-memory table. Until the first rebuild every name may
+    // exist. Takes as long as a scan of the account table, so run it at
+    // startup or on the auth pool; a second call while one runs returns at
+    // once. False if the store could not be read (the old filter stays).
+    // The first rebuild after a successful catch_up reads the snapshot
+    // instead, which takes milliseconds.
+    bool rebuild_username_filter();
     
-    void create_test_accounts() {
-        // Create some test accounts for development
-        create_account("test", "test");
-        create_account("admin", "admin");
-        create_account("dev", "dev");
+    // Accounts are never removed, so the pointer stays valid
+    Account* get_account(std::string_view username) const {
+        const Shard& shard = shard_for(username);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.accounts.find(username);
+        return (it != shard.accounts.end()) ? it->second : nullptr;
     }
     
+    // Null if the account is not in memory
+    Account* get_account_by_id(u32 account_id) const { return pool_.find(account_id); }
+    
+    // Add an account with an already computed bcrypt hash (tools,
+    // benchmarks); memory only, never written to a store. Returns the new
+    // id, or 0 if the name exists. Throws AccountStoreError if a store is
+    // set and no id block can be leased.
+    u32 add_account(std::string_view username, std::string_view password_hash);
+    
+    // Create some test accounts for development
+    void create_test_accounts();
+    
+    // Both drop the account's cached credential. False if there is no such
+    // account, or the new password could not be hashed.
+    bool set_password(std::string_view username, std::string_view password);
+    bool set_active(std::string_view username, bool active);
+    
     size_t get_account_count() const {
-        return accounts_.size();
+        return account_count_.load(std::memory_order_relaxed);
     }
+    
+    // Record, string and index bytes held for accounts (excludes the shard maps)
+    size_t memory_reserved() const { return pool_.bytes_reserved(); }
+    
+    void log_stats() const;
 
 private:
-    AccountManager() = default;
+    // The table is split into lock-striped shards by username hash, so
+    // logins for different accounts rarely touch the same lock or cache line
+    static constexpr size_t SHARD_COUNT = 64;
+    
+    // Keys view the record's own username
+    struct alignas(64) Shard {
+        mutable std::mutex mutex;
+        std::unordered_map<std::string_view, Account*, StringHash, std::equal_to<>> accounts;
+    };
     
-    u32 create_account(const std::string& username, const std::string& password) {
-        u32 new_id = next_account_id_++;
-        auto account = std::make_shared<Account>(new_id, username, password);
-        accounts_[username] = account;
+    AccountManager();
+    
+    Shard& shard_for(std::string_view username) {
+        return shards_[StringHash{}(username) % SHARD_COUNT];
+    }
+    const Shard& shard_for(std::string_view username) const {
+        return shards_[StringHash{}(username) % SHARD_COUNT];
+    }
+    
+    // Callers hold shard.mutex; the hash and the id are obtained before taking it
+    u32 create_account(Shard& shard, u32 new_id, std::string_view username, std::string_view password_hash) {
+        Account* account = pool_.create(new_id, username, password_hash);
+        shard.accounts.emplace(account->username, account);
+        account_count_.fetch_add(1, std::memory_order_relaxed);
+        note_username(username);
         return new_id;
     }
     
-    LoginResult try_auto_create_account(const std::string& username, const std::string& password);
+    // False only if username is certainly not an account
+    bool username_may_exist(std::string_view username) const {
+        std::shared_ptr<BloomFilter> filter = username_filter_.load(std::memory_order_acquire);
+        return !filter || filter->may_contain(username);
+    }
+    
+    // Adds a name to the filter and to one being rebuilt. Called after the
+    // account is in its shard, so a rebuild either sees it there or here.
+    void note_username(std::string_view username);
+    
+    // In the table, else from the store (and then cached); null if neither has it
+    Account* find_or_load(std::string_view username);
+    
+    // Cache a stored account unless another thread got there first; returns the cached one
+    Account* insert_stored(const StoredAccount& stored);
+    
+    LoginResult try_auto_create_account(std::string_view username, std::string_view password);
+    
+    // Counts a successful login here and, with a store, queues it for writing
+    void record_login(Account& account);
+    
+    // Brings the record for a changed stored account up to date; true if
+    // anything changed
+    bool apply_change(const StoredAccount& stored);
+    
+    AccountPool pool_;
+    std::array<Shard, SHARD_COUNT> shards_;
+    std::atomic<size_t> account_count_{0};
+    
+    // Internally synchronized; used without holding any shard lock
+    CredentialCache credentials_;
+    AccountIdAllocator account_ids_;
+    std::shared_ptr<AccountStore> store_;
+    std::unique_ptr<LoginStatsWriter> login_stats_;
+    
+    // Set before serving and never replaced; catch-up keeps memory current
+    std::unique_ptr<AccountSnapshot> snapshot_;
+    std::atomic<i64> catch_up_since_{0};  // Store clock, unix seconds
+    std::atomic<bool> catch_up_running_{false};
+    std::atomic<bool> caught_up_{false};
+    std::atomic<u64> snapshot_hits_{0};
+    std::atomic<u64> catch_up_changes_{0};
     
-    std::unordered_map<std::string, std::shared_ptr<Account>> accounts_;
-    u32 next_account_id_ = 1000;
+    // Lookups of names the filter rules out never reach a shard or the store
+    std::atomic<std::shared_ptr<BloomFilter>> username_filter_;
+    std::atomic<std::shared_ptr<BloomFilter>> rebuilding_filter_;
+    std::atomic<bool> rebuild_running_{false};
+    std::atomic<u64> filtered_unknown_{0};     // Rejected by the filter alone
+    std::atomic<u64> filter_false_positive_{0}; // Passed the filter, then not found
 };
 
 } // namespace swganh
\ No newline at end of file
@@ -0,0 +1,75 @@
+// File: src/core/account_pool.cpp
+#include "account_pool.hpp"
+
+#include <cstring>
+
+namespace swganh {
+
+Account* AccountPool::create(u32 account_id, std::string_view username, std::string_view password_hash) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (chunk_used_ == RECORDS_PER_CHUNK) {
+        chunks_.push_back(std::make_unique<Account[]>(RECORDS_PER_CHUNK));
+        chunk_used_ = 0;
+    }
+    Account* account = &chunks_.back()[chunk_used_++];
+    account->account_id = account_id;
+    account->username = intern_locked(username);
+    account->password_hash = intern_locked(password_hash);
+
+    if (account_id < by_id_.size() || account_id < count_ * 2 + DENSE_SLACK) {
+        if (account_id >= by_id_.size()) by_id_.resize(static_cast<size_t>(account_id) + 1, nullptr);
+        by_id_[account_id] = account;
+    } else {
+        sparse_by_id_[account_id] = account;
+    }
+    ++count_;
+    return account;
+}
+
+std::string_view AccountPool::intern(std::string_view text) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return intern_locked(text);
+}
+
+std::string_view AccountPool::intern_locked(std::string_view text) {
+    if (text.empty()) return {};
+
+    // Anything large gets a block of its own rather than wasting a shared one
+    if (text.size() > ARENA_BLOCK / 4) {
+        large_.push_back(std::make_unique<char[]>(text.size()));
+        std::memcpy(large_.back().get(), text.data(), text.size());
+        arena_bytes_ += text.size();
+        return std::string_view(large_.back().get(), text.size());
+    }
+
+    if (ARENA_BLOCK - block_used_ < text.size()) {
+        blocks_.push_back(std::make_unique<char[]>(ARENA_BLOCK));
+        block_used_ = 0;
+        arena_bytes_ += ARENA_BLOCK;
+    }
+    char* out = blocks_.back().get() + block_used_;
+    std::memcpy(out, text.data(), text.size());
+    block_used_ += text.size();
+    return std::string_view(out, text.size());
+}
+
+Account* AccountPool::find(u32 account_id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (account_id < by_id_.size() && by_id_[account_id]) return by_id_[account_id];
+    auto it = sparse_by_id_.find(account_id);
+    return it != sparse_by_id_.end() ? it->second : nullptr;
+}
+
+size_t AccountPool::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return count_;
+}
+
+size_t AccountPool::bytes_reserved() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return chunks_.size() * RECORDS_PER_CHUNK * sizeof(Account) + arena_bytes_ +
+           by_id_.capacity() * sizeof(Account*);
+}
+
+} // namespace swganh
@@ -0,0 +1,84 @@
+// File: src/core/account_pool.hpp
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "types.hpp"
+
+namespace swganh {
+
+// Bit flags carried in session tokens
+enum AccountPermission : u32 {
+    PERMISSION_PLAYER = 0,
+    PERMISSION_CSR    = 1u << 0,
+    PERMISSION_ADMIN  = 1u << 1
+};
+
+// Records live in an AccountPool and are never freed or moved, so an
+// Account* stays valid for the life of the process. The strings point into
+// the pool's arena. Fields that change after creation are atomic or guarded
+// by the owning AccountManager shard's lock.
+struct Account {
+    u32 account_id = 0;
+    std::atomic<u32> permissions{PERMISSION_PLAYER};
+    std::string_view username;
+    std::string_view password_hash;  // bcrypt, see PasswordHash; shard lock
+    std::atomic<i64> last_login{0};  // Unix seconds, 0 = never
+    std::atomic<u32> login_count{0};
+    std::atomic<bool> is_active{true};
+};
+
+// Storage for every account: records sit side by side in fixed chunks,
+// their strings are packed into large arena blocks, and a dense vector maps
+// account id to record. Per account that is the record, the two strings'
+// bytes and one index slot, with no per-record allocation or control block.
+class AccountPool {
+public:
+    AccountPool() = default;
+    AccountPool(const AccountPool&) = delete;
+    AccountPool& operator=(const AccountPool&) = delete;
+
+    // Thread safe. The record is not visible to anyone until the caller
+    // publishes the pointer.
+    Account* create(u32 account_id, std::string_view username, std::string_view password_hash);
+
+    // Copies text into the arena, e.g. a changed password hash. The old bytes
+    // stay behind (readers may still hold them); passwords rarely change.
+    std::string_view intern(std::string_view text);
+
+    // Null if there is no such account
+    Account* find(u32 account_id) const;
+
+    size_t size() const;
+    size_t bytes_reserved() const;
+
+private:
+    static constexpr size_t RECORDS_PER_CHUNK = 4096;
+    static constexpr size_t ARENA_BLOCK = 64 * 1024;
+
+    // Ids beyond this much empty space go to the sparse map instead of
+    // growing the dense index; store ids come from a sequence, so rarely
+    static constexpr size_t DENSE_SLACK = 65536;
+
+    std::string_view intern_locked(std::string_view text);
+
+    mutable std::mutex mutex_;
+
+    std::vector<std::unique_ptr<Account[]>> chunks_;
+    size_t chunk_used_ = RECORDS_PER_CHUNK;
+    size_t count_ = 0;
+
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    std::vector<std::unique_ptr<char[]>> large_;
+    size_t block_used_ = ARENA_BLOCK;
+    size_t arena_bytes_ = 0;
+
+    std::vector<Account*> by_id_;
+    std::unordered_map<u32, Account*> sparse_by_id_;
+};
+
+} // namespace swganh
@@ -0,0 +1,198 @@
+// File: src/core/account_snapshot.cpp
+#include "account_snapshot.hpp"
+#include "logger.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace swganh {
+
+u32 AccountSnapshot::name_hash(std::string_view name) {
+    // FNV-1a
+    u32 hash = 2166136261u;
+    for (char c : name) {
+        hash ^= static_cast<u8>(c);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+std::unique_ptr<AccountSnapshot> AccountSnapshot::open(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        if (errno != ENOENT) {
+            LOG_WARNING_F("Account snapshot '{}' not opened: {}", path, std::strerror(errno));
+        }
+        return nullptr;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(Header)) {
+        ::close(fd);
+        LOG_WARNING_F("Account snapshot '{}' is too small", path);
+        return nullptr;
+    }
+    size_t size = static_cast<size_t>(info.st_size);
+    if (info.st_mode & (S_IRWXG | S_IRWXO)) {
+        LOG_WARNING_F("Account snapshot '{}' holds password hashes but is accessible to group or others; "
+                      "chmod 600 it", path);
+    }
+
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        LOG_WARNING_F("Account snapshot '{}': mmap failed: {}", path, std::strerror(errno));
+        return nullptr;
+    }
+    // Lookups jump around; read-ahead would only pull in pages nobody asked for
+    madvise(mapping, size, MADV_RANDOM);
+
+    std::unique_ptr<AccountSnapshot> snapshot(new AccountSnapshot());
+    snapshot->mapping_ = mapping;
+    snapshot->mapping_size_ = size;
+
+    Header header;
+    std::memcpy(&header, mapping, sizeof(header));
+    u64 expected = sizeof(Header) + u64(header.record_count) * sizeof(Record) +
+                   u64(header.slot_count) * sizeof(u32) + header.string_bytes;
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION ||
+        !std::has_single_bit(header.slot_count) || header.slot_count < header.record_count ||
+        expected != size) {
+        LOG_WARNING_F("Account snapshot '{}' is not a valid version {} snapshot", path, VERSION);
+        return nullptr;
+    }
+
+    const char* base = static_cast<const char*>(mapping);
+    snapshot->records_ = reinterpret_cast<const Record*>(base + sizeof(Header));
+    snapshot->slots_ = reinterpret_cast<const u32*>(snapshot->records_ + header.record_count);
+    snapshot->strings_ = reinterpret_cast<const char*>(snapshot->slots_ + header.slot_count);
+    snapshot->record_count_ = header.record_count;
+    snapshot->slot_count_ = header.slot_count;
+    snapshot->string_bytes_ = header.string_bytes;
+    snapshot->as_of_ = header.as_of;
+    return snapshot;
+}
+
+AccountSnapshot::~AccountSnapshot() {
+    if (mapping_) munmap(mapping_, mapping_size_);
+}
+
+std::string_view AccountSnapshot::text(u32 offset, u16 length) const {
+    if (u64(offset) + length > string_bytes_) return {};
+    return std::string_view(strings_ + offset, length);
+}
+
+std::optional<StoredAccount> AccountSnapshot::find(std::string_view username) const {
+    if (record_count_ == 0) return std::nullopt;
+
+    u32 hash = name_hash(username);
+    u32 mask = slot_count_ - 1;
+    for (u32 probe = 0, slot = hash & mask; probe < slot_count_; ++probe, slot = (slot + 1) & mask) {
+        u32 entry = slots_[slot];
+        if (entry == 0 || entry > record_count_) return std::nullopt;
+
+        const Record& record = records_[entry - 1];
+        if (record.name_hash != hash || text(record.username_offset, record.username_length) != username) {
+            continue;
+        }
+
+        StoredAccount account;
+        account.account_id = record.account_id;
+        account.username = std::string(username);
+        account.password_hash = std::string(text(record.hash_offset, record.hash_length));
+        account.is_active = (record.flags & RECORD_ACTIVE) != 0;
+        account.login_count = record.login_count;
+        account.permissions = record.permissions;
+        return account;
+    }
+    return std::nullopt;
+}
+
+void AccountSnapshot::for_each_username(const std::function<void(std::string_view)>& visit) const {
+    for (u32 i = 0; i < record_count_; ++i) {
+        std::string_view username = text(records_[i].username_offset, records_[i].username_length);
+        if (!username.empty()) visit(username);
+    }
+}
+
+void AccountSnapshot::Writer::add(const StoredAccount& account) {
+    if (account.username.size() > std::numeric_limits<u16>::max() ||
+        account.password_hash.size() > std::numeric_limits<u16>::max() ||
+        strings_.size() + account.username.size() + account.password_hash.size() > std::numeric_limits<u32>::max() ||
+        records_.size() >= std::numeric_limits<u32>::max() / 2) {
+        overflow_ = true;
+        return;
+    }
+
+    Record record{};
+    record.account_id = account.account_id;
+    record.permissions = account.permissions;
+    record.login_count = account.login_count;
+    record.flags = account.is_active ? u32(RECORD_ACTIVE) : 0u;
+    record.username_offset = static_cast<u32>(strings_.size());
+    record.username_length = static_cast<u16>(account.username.size());
+    strings_ += account.username;
+    record.hash_offset = static_cast<u32>(strings_.size());
+    record.hash_length = static_cast<u16>(account.password_hash.size());
+    strings_ += account.password_hash;
+    record.name_hash = name_hash(account.username);
+    records_.push_back(record);
+}
+
+bool AccountSnapshot::Writer::finish(const std::string& path, i64 as_of) {
+    if (overflow_) {
+        LOG_ERROR("Account snapshot: accounts do not fit the format, not written");
+        return false;
+    }
+
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.record_count = static_cast<u32>(records_.size());
+    header.slot_count = std::bit_ceil(std::max<u32>(2 * header.record_count, 16));
+    header.as_of = as_of;
+
+    std::vector<u32> slots(header.slot_count, 0);
+    u32 mask = header.slot_count - 1;
+    for (u32 i = 0; i < header.record_count; ++i) {
+        u32 slot = records_[i].name_hash & mask;
+        while (slots[slot] != 0) slot = (slot + 1) & mask;
+        slots[slot] = i + 1;
+    }
+    header.string_bytes = strings_.size();
+
+    // Owner-only from creation: the file holds every account's password hash
+    std::string temp = path + ".tmp";
+    int fd = ::open(temp.c_str(), O_CREAT | O_TRUNC | O_WRONLY | O_CLOEXEC, 0600);
+    FILE* file = fd >= 0 ? fdopen(fd, "wb") : nullptr;
+    if (!file) {
+        LOG_ERROR_F("Account snapshot: cannot write '{}': {}", temp, std::strerror(errno));
+        if (fd >= 0) ::close(fd);
+        return false;
+    }
+    // A temp file left behind by an older build may have looser permissions
+    fchmod(fd, 0600);
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+              std::fwrite(records_.data(), sizeof(Record), records_.size(), file) == records_.size() &&
+              std::fwrite(slots.data(), sizeof(u32), slots.size(), file) == slots.size() &&
+              std::fwrite(strings_.data(), 1, strings_.size(), file) == strings_.size() &&
+              std::fflush(file) == 0 && fsync(fileno(file)) == 0;
+    ok = std::fclose(file) == 0 && ok;
+    if (!ok || std::rename(temp.c_str(), path.c_str()) != 0) {
+        LOG_ERROR_F("Account snapshot: writing '{}' failed: {}", path, std::strerror(errno));
+        std::remove(temp.c_str());
+        return false;
+    }
+    return true;
+}
+
+} // namespace swganh
@@ -0,0 +1,114 @@
+// File: src/core/account_snapshot.hpp
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "types.hpp"
+#include "account_store.hpp"
+
+namespace swganh {
+
+// Read-only, memory-mapped image of the account table, so a restarted login
+// server can answer its first logins without warming a cache from SQL.
+// Opening costs an mmap and a header check; a lookup hashes the name, probes
+// an open-addressing index and touches the pages it needs.
+//
+// Layout, native byte order (a snapshot is read by the host that wrote it):
+//
+//   Header
+//   Record[record_count]     32 bytes each
+//   u32 slots[slot_count]    0 = empty, else record index + 1; linear probing
+//   char strings[string_bytes]
+//
+// Every offset is bounds-checked on use, so a truncated or corrupt file
+// yields misses, never reads outside the mapping.
+class AccountSnapshot {
+public:
+    // Null if the file is missing or not a valid snapshot (logged)
+    static std::unique_ptr<AccountSnapshot> open(const std::string& path);
+
+    ~AccountSnapshot();
+    AccountSnapshot(const AccountSnapshot&) = delete;
+    AccountSnapshot& operator=(const AccountSnapshot&) = delete;
+
+    std::optional<StoredAccount> find(std::string_view username) const;
+
+    void for_each_username(const std::function<void(std::string_view)>& visit) const;
+
+    size_t size() const { return record_count_; }
+
+    // Database clock (unix seconds) when the rows were read; changes from
+    // then on are missing and must be caught up from the store
+    i64 as_of() const { return as_of_; }
+
+    class Writer;
+
+private:
+    static constexpr char MAGIC[8] = {'S', 'W', 'G', 'A', 'C', 'C', 'T', '\0'};
+    static constexpr u32 VERSION = 1;
+
+    struct Header {
+        char magic[8];
+        u32 version;
+        u32 record_count;
+        u32 slot_count;  // Power of two, at least twice record_count
+        u32 reserved;
+        i64 as_of;
+        u64 string_bytes;
+    };
+
+    enum RecordFlags : u32 {
+        RECORD_ACTIVE = 1u << 0
+    };
+
+    struct Record {
+        u32 account_id;
+        u32 permissions;
+        u32 login_count;
+        u32 flags;
+        u32 username_offset;
+        u32 hash_offset;
+        u16 username_length;
+        u16 hash_length;
+        u32 name_hash;
+    };
+    static_assert(sizeof(Record) == 32);
+
+    // Stable across builds and standard libraries, unlike std::hash
+    static u32 name_hash(std::string_view name);
+
+    AccountSnapshot() = default;
+
+    std::string_view text(u32 offset, u16 length) const;
+
+    void* mapping_ = nullptr;
+    size_t mapping_size_ = 0;
+
+    const Record* records_ = nullptr;
+    const u32* slots_ = nullptr;
+    const char* strings_ = nullptr;
+    u32 record_count_ = 0;
+    u32 slot_count_ = 0;
+    u64 string_bytes_ = 0;
+    i64 as_of_ = 0;
+};
+
+// Packs accounts as they stream in from the store, then writes the file
+// atomically (temp file + rename), so a reader never maps a partial one
+class AccountSnapshot::Writer {
+public:
+    void add(const StoredAccount& account);
+    bool finish(const std::string& path, i64 as_of);
+    size_t size() const { return records_.size(); }
+
+private:
+    std::vector<Record> records_;
+    std::string strings_;
+    bool overflow_ = false;  // Something did not fit the format
+};
+
+} // namespace swganh
@@ -0,0 +1,78 @@
+// File: src/core/account_store.hpp
+#pragma once
+
+#include <functional>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include "types.hpp"
+
+namespace swganh {
+
+// One row of account.accounts
+struct StoredAccount {
+    u32 account_id = 0;  // station_id
+    std::string username;
+    std::string password_hash;
+    bool is_active = true;
+    u32 login_count = 0;
+    u32 permissions = 0;
+};
+
+// Logins since the last flush, summed per account
+struct LoginStatsUpdate {
+    u32 account_id = 0;
+    u32 logins = 0;
+    i64 last_login = 0;  // Unix seconds
+};
+
+// Account ids [first, first + count) reserved for one login server
+struct IdBlock {
+    u32 first = 0;
+    u32 count = 0;
+};
+
+// The store could not answer (connection lost, pool exhausted, bad schema)
+struct AccountStoreError : std::runtime_error {
+    using std::runtime_error::runtime_error;
+};
+
+// Durable home of the accounts. AccountManager keeps the working set in
+// memory and asks the store on a miss. Implementations are thread safe and
+// block for network round trips, so they are called from the auth pool,
+// never from an IO thread.
+class AccountStore {
+public:
+    virtual ~AccountStore() = default;
+
+    // nullopt if there is no such account; throws AccountStoreError
+    virtual std::optional<StoredAccount> find_account(std::string_view username) = 0;
+
+    // Inserts an account under an id from lease_account_ids. False if the
+    // username is taken (the id is then unused); throws AccountStoreError
+    virtual bool create_account(u32 account_id, std::string_view username, std::string_view password_hash) = 0;
+
+    // Reserves count ids no other caller, on any server, will be given.
+    // Atomic in the store; throws AccountStoreError, also when ids run out
+    virtual IdBlock lease_account_ids(u32 count) = 0;
+
+    // Calls visit once per account, streaming rather than buffering the
+    // table; throws AccountStoreError (visit may have seen some names by then)
+    virtual void scan_usernames(const std::function<void(std::string_view)>& visit) = 0;
+
+    // Calls visit for every account created or changed (password, status,
+    // permissions) at or after since, unix seconds on the store's clock; 0
+    // visits them all. Returns the store's clock when the read began, the
+    // since to use next time. Throws AccountStoreError.
+    virtual i64 scan_changed_since(i64 since, const std::function<void(const StoredAccount&)>& visit) = 0;
+
+    // Adds each update's logins to login_count and sets last_login, all rows
+    // in one statement; throws AccountStoreError and then applies none of them
+    virtual void update_login_stats(std::span<const LoginStatsUpdate> updates) = 0;
+
+    virtual void log_stats() const {}
+};
+
+} // namespace swganh
@@ -0,0 +1,85 @@
+// File: src/core/bloom_filter.hpp
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string_view>
+#include "types.hpp"
+
+namespace swganh {
+
+// Split-block Bloom filter: a key sets one bit in each of the eight 32-bit
+// words of a single 32-byte block, so a lookup reads one cache line and
+// never misses a key that was inserted. At 16 bits per key about 0.1% of
+// absent keys are reported as present.
+//
+// Inserts and lookups may run concurrently from any thread; bits are only
+// ever set, with relaxed atomics.
+class BloomFilter {
+public:
+    explicit BloomFilter(size_t expected_keys, u32 bits_per_key = 16)
+        : block_count_(block_count_for(expected_keys, bits_per_key)),
+          blocks_(std::make_unique<Block[]>(block_count_)) {}
+
+    void insert(std::string_view key) {
+        u64 h = hash(key);
+        Block& block = blocks_[block_index(h)];
+        for (u32 i = 0; i < 8; ++i) {
+            block.words[i].fetch_or(bit(h, i), std::memory_order_relaxed);
+        }
+    }
+
+    // False only if key was never inserted
+    bool may_contain(std::string_view key) const {
+        u64 h = hash(key);
+        const Block& block = blocks_[block_index(h)];
+        for (u32 i = 0; i < 8; ++i) {
+            if ((block.words[i].load(std::memory_order_relaxed) & bit(h, i)) == 0) return false;
+        }
+        return true;
+    }
+
+    size_t size_bytes() const { return block_count_ * sizeof(Block); }
+
+private:
+    struct alignas(32) Block {
+        std::atomic<u32> words[8] = {};
+    };
+
+    static constexpr u32 SALTS[8] = {
+        0x47b6137bu, 0x44974d91u, 0x8824ad5bu, 0xa2b7289du,
+        0x705495c7u, 0x2df1424bu, 0x9efc4947u, 0x5c6bfb31u
+    };
+
+    static size_t block_count_for(size_t expected_keys, u32 bits_per_key) {
+        size_t bits = (expected_keys > 0 ? expected_keys : 1) * bits_per_key;
+        size_t blocks = (bits + 255) / 256;
+        return blocks > 0 ? blocks : 1;
+    }
+
+    // std::hash, then a splitmix64 finalizer so both halves are well mixed
+    static u64 hash(std::string_view key) {
+        u64 h = std::hash<std::string_view>{}(key);
+        h ^= h >> 30;
+        h *= 0xbf58476d1ce4e5b9ull;
+        h ^= h >> 27;
+        h *= 0x94d049bb133111ebull;
+        h ^= h >> 31;
+        return h;
+    }
+
+    // High half picks the block, low half the bits within it
+    size_t block_index(u64 h) const {
+        return static_cast<size_t>(((h >> 32) * block_count_) >> 32);
+    }
+
+    static u32 bit(u64 h, u32 i) {
+        return 1u << ((static_cast<u32>(h) * SALTS[i]) >> 27);
+    }
+
+    size_t block_count_;
+    std::unique_ptr<Block[]> blocks_;
+};
+
+} // namespace swganh
@@ -0,0 +1,98 @@
+// File: src/core/character_manager.cpp
+#include "character_manager.hpp"
+#include "config.hpp"
+#include "logger.hpp"
+
+#include <algorithm>
+#include <cctype>
+
+namespace swganh {
+
+namespace {
+
+std::string lower_name(std::string_view name) {
+    std::string lower(name);
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return lower;
+}
+
+} // namespace
+
+u64 CharacterManager::create_character(u32 account_id, std::string_view name, std::string_view species,
+                                       std::string_view profession, u8 gender) {
+    size_t max_characters = static_cast<size_t>(Config::instance().get_int("max_characters_per_account", 2));
+    u64 character_id = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<Character>& characters = by_account_[account_id];
+        if (characters.size() >= max_characters) {
+            LOG_WARNING_F("Account {} already has {} characters", account_id, characters.size());
+            return 0;
+        }
+        if (!names_.insert(lower_name(name)).second) {
+            LOG_WARNING_F("Character name '{}' is taken", name);
+            return 0;
+        }
+        
+        character_id = next_character_id_++;
+        characters.push_back(Character{character_id, account_id, std::string(name), std::string(species),
+                                       std::string(profession), gender, "tatooine"});
+    }
+    
+    LOG_INFO_F("Created character {} '{}' for account {}", character_id, name, account_id);
+    notify(account_id);
+    return character_id;
+}
+
+bool CharacterManager::delete_character(u64 character_id) {
+    u32 account_id = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        bool found = false;
+        for (auto& [owner, characters] : by_account_) {
+            auto it = std::find_if(characters.begin(), characters.end(),
+                                   [&](const Character& c) { return c.character_id == character_id; });
+            if (it != characters.end()) {
+                names_.erase(lower_name(it->name));
+                characters.erase(it);
+                account_id = owner;
+                found = true;
+                break;
+            }
+        }
+        if (!found) return false;
+    }
+    
+    LOG_INFO_F("Deleted character {} of account {}", character_id, account_id);
+    notify(account_id);
+    return true;
+}
+
+std::vector<Character> CharacterManager::get_characters(u32 account_id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = by_account_.find(account_id);
+    return it != by_account_.end() ? it->second : std::vector<Character>{};
+}
+
+void CharacterManager::add_change_listener(ChangeListener listener) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    listeners_.push_back(std::move(listener));
+}
+
+void CharacterManager::notify(u32 account_id) {
+    std::vector<ChangeListener> listeners;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        listeners = listeners_;
+    }
+    for (const ChangeListener& listener : listeners) {
+        listener(account_id);
+    }
+}
+
+void CharacterManager::create_test_characters(u32 account_id) {
+    create_character(account_id, "Testchar", "object/creature/player/shared_human_male.iff", "combat_brawler", 0);
+}
+
+} // namespace swganh
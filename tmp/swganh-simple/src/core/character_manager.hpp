@@ -0,0 +1,65 @@
+// File: src/core/character_manager.hpp
+#pragma once
+
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "types.hpp"
+
+namespace swganh {
+
+// A row of game.characters as far as the login server cares
+struct Character {
+    u64 character_id;      // SWG object id
+    u32 account_id;
+    std::string name;
+    std::string species;   // Template, e.g. "object/creature/player/shared_human_male.iff"
+    std::string profession;
+    u8 gender;             // 0 = male, 1 = female
+    std::string planet;
+};
+
+// In-memory stand-in for game.characters, indexed by account
+class CharacterManager {
+public:
+    // Called with the account id after one of its characters was created or deleted
+    using ChangeListener = std::function<void(u32 account_id)>;
+    
+    static CharacterManager& instance() {
+        static CharacterManager inst;
+        return inst;
+    }
+    
+    // Returns the new character id, or 0 if the name is taken or the account
+    // already has max_characters_per_account characters
+    u64 create_character(u32 account_id, std::string_view name, std::string_view species,
+                         std::string_view profession, u8 gender);
+    
+    bool delete_character(u64 character_id);
+    
+    // Copy of the account's characters in creation order
+    std::vector<Character> get_characters(u32 account_id) const;
+    
+    // Listeners run on the mutating thread after the change is visible, and
+    // must not call back into create/delete
+    void add_change_listener(ChangeListener listener);
+    
+    void create_test_characters(u32 account_id);
+
+private:
+    CharacterManager() = default;
+    
+    void notify(u32 account_id);
+    
+    std::unordered_map<u32, std::vector<Character>> by_account_;
+    std::unordered_set<std::string> names_;  // Lower-case; names are unique per galaxy
+    u64 next_character_id_ = 8000000000ULL;
+    std::vector<ChangeListener> listeners_;
+    mutable std::mutex mutex_;
+};
+
+} // namespace swganh
@@ -0,0 +1,115 @@
+// File: src/core/credential_cache.cpp
+#include "credential_cache.hpp"
+#include "logger.hpp"
+
+#include <openssl/crypto.h>
+#include <openssl/rand.h>
+#include <stdexcept>
+
+namespace swganh {
+
+namespace {
+
+std::array<u8, 32> random_key() {
+    std::array<u8, 32> key;
+    if (RAND_bytes(key.data(), static_cast<int>(key.size())) != 1) {
+        throw std::runtime_error("RAND_bytes failed");
+    }
+    return key;
+}
+
+std::span<const u8> bytes_of(std::string_view text) {
+    return std::span<const u8>(reinterpret_cast<const u8*>(text.data()), text.size());
+}
+
+} // namespace
+
+CredentialCache::CredentialCache(std::chrono::seconds ttl, size_t max_entries)
+    : ttl_(ttl), max_entries_per_shard_(max_entries / SHARD_COUNT > 0 ? max_entries / SHARD_COUNT : 1),
+      mac_(random_key()) {
+}
+
+HmacSha256::Digest CredentialCache::digest(std::string_view password, std::string_view password_hash) const {
+    // The bcrypt hash is fixed-length, so hash || password is unambiguous
+    return mac_.compute(bytes_of(password_hash), bytes_of(password));
+}
+
+bool CredentialCache::check(u32 account_id, std::string_view password, std::string_view password_hash) {
+    return check(account_id, password, password_hash, Clock::now());
+}
+
+bool CredentialCache::check(u32 account_id, std::string_view password, std::string_view password_hash,
+                            Clock::time_point now) {
+    if (ttl_.count() <= 0) return false;
+
+    HmacSha256::Digest expected;
+    {
+        Shard& shard = shard_for(account_id);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.entries.find(account_id);
+        if (it == shard.entries.end()) {
+            misses_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        if (it->second.expires_at <= now) {
+            shard.entries.erase(it);
+            misses_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        expected = it->second.digest;
+    }
+
+    bool match = CRYPTO_memcmp(expected.data(), digest(password, password_hash).data(), expected.size()) == 0;
+    (match ? hits_ : misses_).fetch_add(1, std::memory_order_relaxed);
+    return match;
+}
+
+void CredentialCache::remember(u32 account_id, std::string_view password, std::string_view password_hash) {
+    remember(account_id, password, password_hash, Clock::now());
+}
+
+void CredentialCache::remember(u32 account_id, std::string_view password, std::string_view password_hash,
+                               Clock::time_point now) {
+    if (ttl_.count() <= 0) return;
+
+    Entry entry{digest(password, password_hash), now + ttl_};
+
+    Shard& shard = shard_for(account_id);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto& entries = shard.entries;
+    if (entries.size() >= max_entries_per_shard_ && entries.find(account_id) == entries.end()) {
+        // Full: make room by dropping expired entries, else an arbitrary one
+        for (auto it = entries.begin(); it != entries.end();) {
+            it = it->second.expires_at <= now ? entries.erase(it) : std::next(it);
+        }
+        if (entries.size() >= max_entries_per_shard_) entries.erase(entries.begin());
+    }
+    entries[account_id] = entry;
+}
+
+void CredentialCache::invalidate(u32 account_id) {
+    Shard& shard = shard_for(account_id);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.entries.erase(account_id);
+    ++shard.invalidations;
+}
+
+CredentialCacheStats CredentialCache::stats() const {
+    CredentialCacheStats stats;
+    stats.hits = hits_.load(std::memory_order_relaxed);
+    stats.misses = misses_.load(std::memory_order_relaxed);
+    for (const Shard& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        stats.invalidations += shard.invalidations;
+        stats.entries += shard.entries.size();
+    }
+    return stats;
+}
+
+void CredentialCache::log_stats() const {
+    CredentialCacheStats s = stats();
+    LOG_INFO_F("Credential cache: {} entries, {} hits, {} misses, {} invalidations",
+               s.entries, s.hits, s.misses, s.invalidations);
+}
+
+} // namespace swganh
@@ -0,0 +1,81 @@
+// File: src/core/credential_cache.hpp
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include "types.hpp"
+#include "hmac.hpp"
+
+namespace swganh {
+
+struct CredentialCacheStats {
+    u64 hits = 0;
+    u64 misses = 0;
+    u64 invalidations = 0;
+    size_t entries = 0;
+};
+
+// Passwords that passed bcrypt recently, so a client reconnecting after a
+// crash or kick is checked in a microsecond instead of another full hash.
+//
+// Entries hold HMAC-SHA256(process key, stored hash || password), never the
+// password. The key is random per process, so a memory dump gives an
+// attacker nothing to crack offline faster than the bcrypt hashes themselves,
+// and binding the stored hash means a changed password can never match an old
+// entry even before it is invalidated. Entries expire after the TTL.
+class CredentialCache {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // ttl of zero disables the cache; max_entries is split evenly across shards
+    CredentialCache(std::chrono::seconds ttl, size_t max_entries);
+
+    // True if this password was verified against this stored hash within the TTL
+    bool check(u32 account_id, std::string_view password, std::string_view password_hash);
+    bool check(u32 account_id, std::string_view password, std::string_view password_hash, Clock::time_point now);
+
+    // Record a successful bcrypt verification
+    void remember(u32 account_id, std::string_view password, std::string_view password_hash);
+    void remember(u32 account_id, std::string_view password, std::string_view password_hash, Clock::time_point now);
+
+    // Password changed or account disabled
+    void invalidate(u32 account_id);
+
+    CredentialCacheStats stats() const;
+    void log_stats() const;
+
+private:
+    struct Entry {
+        HmacSha256::Digest digest;
+        Clock::time_point expires_at;
+    };
+
+    // Striped by account id like AccountManager, so concurrent logins for
+    // different accounts do not share a lock
+    static constexpr size_t SHARD_COUNT = 16;
+
+    struct alignas(64) Shard {
+        mutable std::mutex mutex;
+        std::unordered_map<u32, Entry> entries;
+        u64 invalidations = 0;
+    };
+
+    HmacSha256::Digest digest(std::string_view password, std::string_view password_hash) const;
+    Shard& shard_for(u32 account_id) { return shards_[account_id % SHARD_COUNT]; }
+
+    std::chrono::seconds ttl_;
+    size_t max_entries_per_shard_;
+    HmacSha256 mac_;
+
+    std::array<Shard, SHARD_COUNT> shards_;
+
+    std::atomic<u64> hits_{0};
+    std::atomic<u64> misses_{0};
+};
+
+} // namespace swganh
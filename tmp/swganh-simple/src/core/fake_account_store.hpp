@@ -0,0 +1,110 @@
+// File: src/core/fake_account_store.hpp
+#pragma once
+
+// Test-only AccountStore shared by the core tests. Lookups find nothing;
+// id leases and login stats writes are recorded, and set_down makes both throw.
+
+#include "account_store.hpp"
+#include "logger.hpp"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace swganh {
+namespace testing {
+
+class FakeAccountStore : public AccountStore {
+public:
+    std::optional<StoredAccount> find_account(std::string_view) override { return std::nullopt; }
+    bool create_account(u32, std::string_view, std::string_view) override { return false; }
+    void scan_usernames(const std::function<void(std::string_view)>&) override {}
+    i64 scan_changed_since(i64, const std::function<void(const StoredAccount&)>&) override { return 0; }
+
+    // Stands in for the account_id_blocks sequence login servers share
+    IdBlock lease_account_ids(u32 count) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (down_) throw AccountStoreError("store down");
+        if (next_block_) return *std::exchange(next_block_, std::nullopt);
+        ++leases_;
+        IdBlock block{next_id_, count};
+        next_id_ += count;
+        return block;
+    }
+
+    // Sums the deltas it was given
+    void update_login_stats(std::span<const LoginStatsUpdate> updates) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (down_) throw AccountStoreError("store down");
+        ++batches_;
+        largest_batch_ = std::max(largest_batch_, updates.size());
+        for (const LoginStatsUpdate& update : updates) {
+            logins_[update.account_id] += update.logins;
+            last_login_[update.account_id] = std::max(last_login_[update.account_id], update.last_login);
+        }
+    }
+
+    void set_down(bool down) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        down_ = down;
+    }
+    // Answer the next lease with this block instead
+    void set_next_block(IdBlock block) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        next_block_ = block;
+    }
+    int leases() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return leases_;
+    }
+    int batches() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return batches_;
+    }
+    size_t largest_batch() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return largest_batch_;
+    }
+    u32 logins(u32 account_id) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = logins_.find(account_id);
+        return it == logins_.end() ? 0 : it->second;
+    }
+    u64 total_logins() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        u64 total = 0;
+        for (const auto& [account_id, logins] : logins_) total += logins;
+        return total;
+    }
+    i64 last_login(u32 account_id) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = last_login_.find(account_id);
+        return it == last_login_.end() ? 0 : it->second;
+    }
+
+private:
+    mutable std::mutex mutex_;
+    bool down_ = false;
+    u32 next_id_ = 1000;
+    int leases_ = 0;
+    std::optional<IdBlock> next_block_;
+    int batches_ = 0;
+    size_t largest_batch_ = 0;
+    std::map<u32, u32> logins_;
+    std::map<u32, i64> last_login_;
+};
+
+// Quiet logger and a fresh store per test
+class FakeAccountStoreTest : public ::testing::Test {
+protected:
+    void SetUp() override { init_logger(LogLevel::ERROR_LEVEL); }
+
+    std::shared_ptr<FakeAccountStore> store_ = std::make_shared<FakeAccountStore>();
+};
+
+} // namespace testing
+} // namespace swganh
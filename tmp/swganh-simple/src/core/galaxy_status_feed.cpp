@@ -0,0 +1,230 @@
+// File: src/core/galaxy_status_feed.cpp
+#include "galaxy_status_feed.hpp"
+#include "logger.hpp"
+
+#include <chrono>
+#include <cerrno>
+#include <cstring>
+#include <random>
+
+#ifdef __unix__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace swganh {
+
+GalaxyStatusFeed::~GalaxyStatusFeed() {
+    close();
+}
+
+u64 GalaxyStatusFeed::now_ms() {
+    // steady_clock is CLOCK_MONOTONIC on Linux, so every process agrees on it
+    return static_cast<u64>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+#ifdef __unix__
+
+bool GalaxyStatusFeed::open_publisher(const std::string& name, u64 max_age_ms) {
+    close();
+    max_age_ms_ = max_age_ms;
+
+    int fd = shm_open(name.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        LOG_ERROR_F("Galaxy status feed: shm_open('{}') failed: {}", name, std::strerror(errno));
+        return false;
+    }
+
+    // A fresh segment is zero-filled, which is a valid empty table
+    if (ftruncate(fd, sizeof(Segment)) != 0) {
+        LOG_ERROR_F("Galaxy status feed: ftruncate failed: {}", std::strerror(errno));
+        ::close(fd);
+        return false;
+    }
+
+    void* mapping = mmap(nullptr, sizeof(Segment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        LOG_ERROR_F("Galaxy status feed: mmap failed: {}", std::strerror(errno));
+        return false;
+    }
+    segment_ = static_cast<Segment*>(mapping);
+
+    u32 expected = 0;
+    if (segment_->magic.load(std::memory_order_acquire) != MAGIC) {
+        segment_->slot_count = MAX_ZONES;
+        segment_->magic.compare_exchange_strong(expected, MAGIC, std::memory_order_release);
+    }
+
+    std::random_device random;
+    do {
+        nonce_ = random();
+    } while (nonce_ == 0);
+
+    if (!claim_slot()) {
+        LOG_ERROR_F("Galaxy status feed: all {} slots in '{}' are in use", MAX_ZONES, name);
+        close();
+        return false;
+    }
+
+    LOG_INFO_F("Publishing galaxy status to shared memory '{}'", name);
+    return true;
+}
+
+bool GalaxyStatusFeed::open_reader(const std::string& name) {
+    close();
+
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) return false;
+
+    struct stat info{};
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(Segment)) {
+        ::close(fd);
+        return false;
+    }
+
+    void* mapping = mmap(nullptr, sizeof(Segment), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) return false;
+
+    segment_ = static_cast<Segment*>(mapping);
+    if (segment_->magic.load(std::memory_order_acquire) != MAGIC) {
+        close();
+        return false;
+    }
+
+    LOG_INFO_F("Reading galaxy status from shared memory '{}'", name);
+    return true;
+}
+
+void GalaxyStatusFeed::close() {
+    if (own_slot_) {
+        // Readers stop counting the slot once it is free; claimed_ms goes
+        // last so nobody claims it while the owner is still being cleared.
+        // A slot that was already taken over is left alone.
+        u32 nonce = nonce_;
+        if (own_slot_->owner.compare_exchange_strong(nonce, 0, std::memory_order_acq_rel)) {
+            own_slot_->updated_ms.store(0, std::memory_order_relaxed);
+            own_slot_->claimed_ms.store(0, std::memory_order_release);
+        }
+        own_slot_ = nullptr;
+    }
+    nonce_ = 0;
+
+    if (segment_) {
+        munmap(segment_, sizeof(Segment));
+        segment_ = nullptr;
+    }
+}
+
+#else
+
+bool GalaxyStatusFeed::open_publisher(const std::string&, u64) {
+    LOG_ERROR("Galaxy status feed needs POSIX shared memory");
+    return false;
+}
+
+bool GalaxyStatusFeed::open_reader(const std::string&) { return false; }
+
+void GalaxyStatusFeed::close() {
+    own_slot_ = nullptr;
+    nonce_ = 0;
+    segment_ = nullptr;
+}
+
+#endif
+
+bool GalaxyStatusFeed::claim_slot() {
+    own_slot_ = nullptr;
+
+    // Whoever moves claimed_ms forward first owns the slot; everybody else
+    // now sees it as fresh and moves on
+    u64 now = now_ms();
+    for (Slot& slot : segment_->slots) {
+        u64 claimed = slot.claimed_ms.load(std::memory_order_acquire);
+        bool claimable = claimed == 0 || claimed + max_age_ms_ < now;
+        if (!claimable || !slot.claimed_ms.compare_exchange_strong(claimed, now, std::memory_order_acq_rel)) {
+            continue;
+        }
+
+        if (slot.owner.load(std::memory_order_relaxed) != 0) {
+            LOG_WARNING_F("Galaxy status feed: reclaiming slot idle for {} ms", now - claimed);
+        }
+        slot.owner.store(nonce_, std::memory_order_release);
+
+        // Whatever the previous owner left is not this zone's population
+        u32 sequence = slot.sequence.load(std::memory_order_relaxed) | 1;
+        slot.sequence.store(sequence, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.updated_ms.store(0, std::memory_order_relaxed);
+        slot.sequence.store(sequence + 1, std::memory_order_release);
+
+        own_slot_ = &slot;
+        return true;
+    }
+    return false;
+}
+
+void GalaxyStatusFeed::publish(u32 galaxy_id, u32 population, u32 max_population) {
+    if (nonce_ == 0) return;  // Not a publisher
+
+    // Stalled past the max age and someone took the slot over
+    if (own_slot_ && own_slot_->owner.load(std::memory_order_acquire) != nonce_) {
+        LOG_WARNING("Galaxy status feed: slot was taken over, claiming another");
+        own_slot_ = nullptr;
+    }
+    if (!own_slot_ && !claim_slot()) return;
+    Slot& slot = *own_slot_;
+
+    u32 sequence = slot.sequence.load(std::memory_order_relaxed);
+    slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.galaxy_id.store(galaxy_id, std::memory_order_relaxed);
+    slot.population.store(population, std::memory_order_relaxed);
+    slot.max_population.store(max_population, std::memory_order_relaxed);
+    slot.updated_ms.store(now_ms(), std::memory_order_relaxed);
+
+    slot.sequence.store(sequence + 2, std::memory_order_release);
+    slot.claimed_ms.store(now_ms(), std::memory_order_release);
+}
+
+GalaxyLoad GalaxyStatusFeed::read(u32 galaxy_id, u64 max_age_ms) const {
+    GalaxyLoad load;
+    if (!segment_) return load;
+
+    u64 now = now_ms();
+    for (const Slot& slot : segment_->slots) {
+        if (slot.owner.load(std::memory_order_relaxed) == 0) continue;
+
+        u32 id = 0, population = 0, max_population = 0;
+        u64 updated = 0;
+        bool consistent = false;
+        // A zone that died mid-write leaves the sequence odd; give up on it
+        for (int attempt = 0; attempt < 64 && !consistent; ++attempt) {
+            u32 before = slot.sequence.load(std::memory_order_acquire);
+            if (before & 1) continue;  // Writer mid-update
+
+            id = slot.galaxy_id.load(std::memory_order_relaxed);
+            population = slot.population.load(std::memory_order_relaxed);
+            max_population = slot.max_population.load(std::memory_order_relaxed);
+            updated = slot.updated_ms.load(std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            consistent = slot.sequence.load(std::memory_order_relaxed) == before;
+        }
+
+        if (!consistent) continue;
+        if (id != galaxy_id || updated == 0 || updated + max_age_ms < now) continue;
+
+        load.population += population;
+        load.max_population += max_population;
+        ++load.zones;
+    }
+    return load;
+}
+
+} // namespace swganh
@@ -0,0 +1,89 @@
+// File: src/core/galaxy_status_feed.hpp
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <string>
+#include "types.hpp"
+
+namespace swganh {
+
+// Live per-galaxy population published by zone processes and read by the
+// login server through a POSIX shared-memory segment.
+//
+// Every zone process owns one slot and is its only writer. A slot is
+// claimed with a random nonce rather than the pid, since two containers can
+// both run their zone as pid 1, and a slot whose owner has not published
+// within the max age is taken over, so crashed zones do not leak slots. Each
+// slot is a
+// seqlock: the writer bumps the sequence to odd, stores the fields, and
+// bumps it back to even; readers retry if the sequence was odd or moved.
+// Reading is a handful of loads - no syscalls, no locks - so the login
+// server can consult it as often as it likes.
+
+struct GalaxyLoad {
+    u32 population = 0;
+    u32 max_population = 0;
+    u32 zones = 0;  // Zone processes that reported recently
+};
+
+class GalaxyStatusFeed {
+public:
+    static constexpr u32 MAGIC = 0x31465347;  // "GSF1"
+    static constexpr size_t MAX_ZONES = 64;
+
+    GalaxyStatusFeed() = default;
+    ~GalaxyStatusFeed();
+
+    GalaxyStatusFeed(const GalaxyStatusFeed&) = delete;
+    GalaxyStatusFeed& operator=(const GalaxyStatusFeed&) = delete;
+
+    // Zone side: create the segment if needed and claim a free slot, or one
+    // whose owner has not published within max_age_ms
+    bool open_publisher(const std::string& name, u64 max_age_ms = 10000);
+
+    // Login side: map an existing segment read-only. Fails until a zone has
+    // created it; callers simply try again later.
+    bool open_reader(const std::string& name);
+
+    void close();
+    bool is_open() const { return segment_ != nullptr; }
+
+    // Zone side: publish this process's share of a galaxy. A publisher that
+    // stalled long enough to lose its slot claims another one.
+    void publish(u32 galaxy_id, u32 population, u32 max_population);
+
+    // Login side: sum of every fresh slot for the galaxy. Slots not updated
+    // within max_age_ms (crashed or stopped zones) are ignored.
+    GalaxyLoad read(u32 galaxy_id, u64 max_age_ms = 10000) const;
+
+private:
+    struct alignas(64) Slot {
+        std::atomic<u32> owner{0};     // Publisher nonce, 0 = free
+        std::atomic<u32> sequence{0};  // Odd while a write is in progress
+        std::atomic<u32> galaxy_id{0};
+        std::atomic<u32> population{0};
+        std::atomic<u32> max_population{0};
+        std::atomic<u64> updated_ms{0};  // CLOCK_MONOTONIC, shared by all processes
+        std::atomic<u64> claimed_ms{0};  // Owner's last claim or publish; 0 = free
+    };
+
+    struct Segment {
+        std::atomic<u32> magic;
+        u32 slot_count;
+        std::array<Slot, MAX_ZONES> slots;
+    };
+
+    static_assert(std::atomic<u32>::is_always_lock_free && std::atomic<u64>::is_always_lock_free,
+                  "seqlock fields must be address-free atomics to live in shared memory");
+
+    static u64 now_ms();
+    bool claim_slot();
+
+    Segment* segment_ = nullptr;
+    Slot* own_slot_ = nullptr;
+    u32 nonce_ = 0;
+    u64 max_age_ms_ = 10000;
+};
+
+} // namespace swganh
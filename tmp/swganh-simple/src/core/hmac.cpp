@@ -0,0 +1,50 @@
+// File: src/core/hmac.cpp
+#include "hmac.hpp"
+
+#include <openssl/core_names.h>
+#include <openssl/evp.h>
+#include <openssl/params.h>
+#include <stdexcept>
+
+namespace swganh {
+
+HmacSha256::HmacSha256(std::span<const u8> key) {
+    EVP_MAC* hmac = EVP_MAC_fetch(nullptr, "HMAC", nullptr);
+    keyed_ = hmac ? EVP_MAC_CTX_new(hmac) : nullptr;
+    EVP_MAC_free(hmac);
+
+    char digest[] = "SHA256";
+    OSSL_PARAM params[] = {
+        OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, digest, 0),
+        OSSL_PARAM_construct_end()
+    };
+    if (!keyed_ || EVP_MAC_init(keyed_, key.data(), key.size(), params) != 1) {
+        EVP_MAC_CTX_free(keyed_);
+        throw std::runtime_error("HMAC-SHA256 unavailable");
+    }
+}
+
+HmacSha256::~HmacSha256() {
+    EVP_MAC_CTX_free(keyed_);
+}
+
+HmacSha256::Digest HmacSha256::compute(std::span<const u8> data) const {
+    return compute(data, {});
+}
+
+HmacSha256::Digest HmacSha256::compute(std::span<const u8> first, std::span<const u8> second) const {
+    Digest digest;
+    size_t length = 0;
+    EVP_MAC_CTX* context = EVP_MAC_CTX_dup(keyed_);
+    bool ok = context
+        && EVP_MAC_update(context, first.data(), first.size()) == 1
+        && EVP_MAC_update(context, second.data(), second.size()) == 1
+        && EVP_MAC_final(context, digest.data(), &length, digest.size()) == 1;
+    EVP_MAC_CTX_free(context);
+    if (!ok || length != SIZE) {
+        throw std::runtime_error("HMAC-SHA256 failed");
+    }
+    return digest;
+}
+
+} // namespace swganh
@@ -0,0 +1,85 @@
+// File: src/core/latency_histogram.hpp
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <vector>
+#include "types.hpp"
+
+namespace swganh {
+
+struct LatencySnapshot {
+    u64 count = 0;
+    u64 p50_ns = 0;
+    u64 p99_ns = 0;
+    u64 p999_ns = 0;
+    u64 max_ns = 0;
+};
+
+// Log-linear histogram of nanosecond latencies: 16 sub-buckets per power of
+// two, so every reported percentile is within ~6% of the true value. One
+// thread records, any thread may read.
+class LatencyHistogram {
+public:
+    static constexpr u32 SUB_BUCKET_BITS = 4;
+    static constexpr u32 SUB_BUCKETS = 1u << SUB_BUCKET_BITS;
+    static constexpr size_t BUCKET_COUNT = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    void record(u64 ns) {
+        auto& bucket = counts_[bucket_index(ns)];
+        bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    // Add this histogram's counts into an accumulator of BUCKET_COUNT entries
+    void accumulate(std::vector<u64>& totals) const {
+        totals.resize(BUCKET_COUNT, 0);
+        for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+            totals[i] += counts_[i].load(std::memory_order_relaxed);
+        }
+    }
+
+    static LatencySnapshot summarize(const std::vector<u64>& totals) {
+        LatencySnapshot snapshot;
+        for (u64 count : totals) snapshot.count += count;
+        if (snapshot.count == 0) return snapshot;
+
+        // Ranks are 1-based: p50 of 10 samples is the 5th smallest
+        u64 p50_rank = (snapshot.count * 500 + 999) / 1000;
+        u64 p99_rank = (snapshot.count * 990 + 999) / 1000;
+        u64 p999_rank = (snapshot.count * 999 + 999) / 1000;
+
+        u64 seen = 0;
+        for (size_t i = 0; i < totals.size(); ++i) {
+            if (totals[i] == 0) continue;
+            u64 before = seen;
+            seen += totals[i];
+            u64 value = bucket_value(i);
+            if (before < p50_rank && seen >= p50_rank) snapshot.p50_ns = value;
+            if (before < p99_rank && seen >= p99_rank) snapshot.p99_ns = value;
+            if (before < p999_rank && seen >= p999_rank) snapshot.p999_ns = value;
+            snapshot.max_ns = value;
+        }
+        return snapshot;
+    }
+
+    static size_t bucket_index(u64 ns) {
+        if (ns < SUB_BUCKETS) return static_cast<size_t>(ns);
+        u32 shift = static_cast<u32>(std::bit_width(ns)) - 1 - SUB_BUCKET_BITS;
+        u64 sub = (ns >> shift) & (SUB_BUCKETS - 1);
+        return (shift + 1) * SUB_BUCKETS + sub;
+    }
+
+    // Lower bound of the values counted in a bucket
+    static u64 bucket_value(size_t index) {
+        if (index < SUB_BUCKETS) return index;
+        u32 shift = static_cast<u32>(index / SUB_BUCKETS) - 1;
+        u64 sub = index % SUB_BUCKETS;
+        return (SUB_BUCKETS + sub) << shift;
+    }
+
+private:
+    std::array<std::atomic<u64>, BUCKET_COUNT> counts_{};
+};
+
+} // namespace swganh
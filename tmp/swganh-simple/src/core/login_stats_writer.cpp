@@ -0,0 +1,146 @@
+// File: src/core/login_stats_writer.cpp
+#include "login_stats_writer.hpp"
+#include "logger.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace swganh {
+
+LoginStatsWriter::LoginStatsWriter(std::shared_ptr<AccountStore> store, std::chrono::milliseconds flush_interval,
+                                   size_t max_batch, std::chrono::milliseconds shutdown_deadline)
+    : store_(std::move(store)), flush_interval_(flush_interval), max_batch_(max_batch > 0 ? max_batch : 1),
+      shutdown_deadline_(shutdown_deadline) {
+    thread_ = std::thread([this]() { run(); });
+}
+
+LoginStatsWriter::~LoginStatsWriter() {
+    stop();
+}
+
+void LoginStatsWriter::record(u32 account_id, i64 last_login) {
+    recorded_.fetch_add(1, std::memory_order_relaxed);
+
+    bool full;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        LoginStatsUpdate& update = pending_[account_id];
+        update.account_id = account_id;
+        update.logins++;
+        update.last_login = std::max(update.last_login, last_login);
+        full = pending_.size() == max_batch_;
+    }
+    if (full) wake_.notify_one();
+}
+
+void LoginStatsWriter::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    bool failed = false;
+    while (!stopping_) {
+        // After a failure wait out the interval, or a full batch would retry at once
+        wake_.wait_for(lock, flush_interval_, [this, failed]() {
+            return stopping_ || (!failed && pending_.size() >= max_batch_);
+        });
+        if (stopping_) break;
+        if (pending_.empty()) continue;
+
+        Pending batch;
+        batch.swap(pending_);
+        lock.unlock();
+        failed = !write(batch);
+        lock.lock();
+    }
+}
+
+bool LoginStatsWriter::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_) return true;
+        stopping_ = true;
+    }
+    wake_.notify_one();
+    if (thread_.joinable()) thread_.join();
+
+    // The thread is gone; pending_ is ours. A failed write merges back into
+    // it, so each attempt takes whatever is left.
+    auto give_up = std::chrono::steady_clock::now() + shutdown_deadline_;
+    std::chrono::milliseconds backoff(100);
+    while (true) {
+        Pending batch;
+        batch.swap(pending_);
+        if (batch.empty() || write(batch)) return true;
+
+        auto now = std::chrono::steady_clock::now();
+        if (now >= give_up) break;
+        std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(backoff, give_up - now));
+        backoff = std::min(backoff * 2, std::chrono::milliseconds(2000));
+    }
+
+    LOG_ERROR_F("Login stats: {} account updates could not be written at shutdown", pending_.size());
+    for (const auto& [account_id, update] : pending_) {
+        LOG_ERROR_F("Login stats unwritten: account_id={} logins={} last_login={}", account_id, update.logins,
+                    update.last_login);
+    }
+    return false;
+}
+
+bool LoginStatsWriter::write(const Pending& batch) {
+    std::vector<LoginStatsUpdate> updates;
+    updates.reserve(batch.size());
+    for (const auto& [account_id, update] : batch) {
+        updates.push_back(update);
+    }
+
+    std::span<const LoginStatsUpdate> all(updates);
+    for (size_t offset = 0; offset < all.size(); offset += max_batch_) {
+        std::span<const LoginStatsUpdate> chunk = all.subspan(offset, std::min(max_batch_, all.size() - offset));
+        auto started = std::chrono::steady_clock::now();
+        try {
+            store_->update_login_stats(chunk);
+        } catch (const AccountStoreError& e) {
+            failures_.fetch_add(1, std::memory_order_relaxed);
+            LOG_WARNING_F("Login stats: batch of {} failed, retrying later: {}", chunk.size(), e.what());
+            requeue(all.subspan(offset));
+            return false;
+        }
+        flush_latency_.record(static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - started).count()));
+        written_.fetch_add(chunk.size(), std::memory_order_relaxed);
+        batches_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+void LoginStatsWriter::requeue(std::span<const LoginStatsUpdate> updates) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const LoginStatsUpdate& failed : updates) {
+        LoginStatsUpdate& update = pending_[failed.account_id];
+        update.account_id = failed.account_id;
+        update.logins += failed.logins;
+        update.last_login = std::max(update.last_login, failed.last_login);
+    }
+}
+
+LoginStatsWriterStats LoginStatsWriter::stats() const {
+    LoginStatsWriterStats stats;
+    stats.recorded = recorded_.load(std::memory_order_relaxed);
+    stats.written = written_.load(std::memory_order_relaxed);
+    stats.batches = batches_.load(std::memory_order_relaxed);
+    stats.failures = failures_.load(std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats.pending = pending_.size();
+    }
+    std::vector<u64> totals;
+    flush_latency_.accumulate(totals);
+    stats.flush = LatencyHistogram::summarize(totals);
+    return stats;
+}
+
+void LoginStatsWriter::log_stats() const {
+    LoginStatsWriterStats s = stats();
+    LOG_INFO_F("Login stats: {} logins -> {} rows in {} batches, {} failed, {} pending, flush p50 {} ns, p99 {} ns",
+               s.recorded, s.written, s.batches, s.failures, s.pending, s.flush.p50_ns, s.flush.p99_ns);
+}
+
+} // namespace swganh
@@ -0,0 +1,88 @@
+// File: src/core/login_stats_writer.hpp
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <unordered_map>
+#include "types.hpp"
+#include "account_store.hpp"
+#include "latency_histogram.hpp"
+
+namespace swganh {
+
+struct LoginStatsWriterStats {
+    u64 recorded = 0;   // Logins passed to record()
+    u64 written = 0;    // Rows sent in successful batches
+    u64 batches = 0;
+    u64 failures = 0;   // Batches kept for the next flush
+    size_t pending = 0; // Accounts waiting to be written
+    LatencySnapshot flush;
+};
+
+// Write-behind for login_count and last_login. A login only updates a map
+// entry here; a background thread writes all pending accounts as multi-row
+// batches. Repeated logins of one account between flushes collapse into a
+// single row, and an update is written at most flush_interval after it was
+// recorded (plus the batch's own round trip) unless the store is down.
+//
+// Updates are deltas, so several login servers can share a database. A
+// failed batch is merged back and retried a full interval later; while the
+// store is down pending holds at most one entry per account.
+class LoginStatsWriter {
+public:
+    // Flushes early once max_batch accounts are pending. stop() keeps
+    // retrying a failed final write for up to shutdown_deadline.
+    LoginStatsWriter(std::shared_ptr<AccountStore> store, std::chrono::milliseconds flush_interval,
+                     size_t max_batch, std::chrono::milliseconds shutdown_deadline);
+    ~LoginStatsWriter();
+
+    LoginStatsWriter(const LoginStatsWriter&) = delete;
+    LoginStatsWriter& operator=(const LoginStatsWriter&) = delete;
+
+    // One successful login; cheap, never touches the store
+    void record(u32 account_id, i64 last_login);
+
+    // Stops the thread and writes whatever is pending, on this thread,
+    // retrying with backoff until the shutdown deadline. Returns false if the
+    // rows still could not be written; each is logged so it can be replayed.
+    bool stop();
+
+    LoginStatsWriterStats stats() const;
+    void log_stats() const;
+
+private:
+    using Pending = std::unordered_map<u32, LoginStatsUpdate>;
+
+    void run();
+
+    // Writes a swapped-out set in chunks of max_batch; whatever was not
+    // written is merged back into pending_. False if a chunk failed.
+    bool write(const Pending& batch);
+    void requeue(std::span<const LoginStatsUpdate> updates);
+
+    std::shared_ptr<AccountStore> store_;
+    std::chrono::milliseconds flush_interval_;
+    size_t max_batch_;
+    std::chrono::milliseconds shutdown_deadline_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    Pending pending_;
+    bool stopping_ = false;
+    std::thread thread_;
+
+    // Recorded by the writer thread, then by stop() after it has joined
+    LatencyHistogram flush_latency_;
+
+    std::atomic<u64> recorded_{0};
+    std::atomic<u64> written_{0};
+    std::atomic<u64> batches_{0};
+    std::atomic<u64> failures_{0};
+};
+
+} // namespace swganh
@@ -0,0 +1,104 @@
+// File: src/core/login_stats_writer_test.cpp
+#include "login_stats_writer.hpp"
+#include "fake_account_store.hpp"
+
+#include <gtest/gtest.h>
+#include <thread>
+
+namespace swganh {
+namespace {
+
+constexpr std::chrono::hours NEVER{1};
+constexpr std::chrono::seconds SHUTDOWN{5};
+
+// Polls until the writer thread has done its part, or gives up
+template<typename Predicate>
+bool eventually(Predicate done) {
+    auto give_up = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!done()) {
+        if (std::chrono::steady_clock::now() > give_up) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return true;
+}
+
+using LoginStatsWriterTest = testing::FakeAccountStoreTest;
+
+TEST_F(LoginStatsWriterTest, RepeatedLoginsCollapseIntoOneRowPerAccount) {
+    LoginStatsWriter writer(store_, NEVER, 1000, SHUTDOWN);
+    for (int i = 0; i < 1000; ++i) writer.record(1000 + i % 10, 1700000000 + i);
+    EXPECT_EQ(store_->batches(), 0);
+
+    ASSERT_TRUE(writer.stop());
+    EXPECT_EQ(store_->batches(), 1);
+    EXPECT_EQ(store_->largest_batch(), 10u);
+    EXPECT_EQ(store_->logins(1000), 100u);
+    EXPECT_EQ(store_->last_login(1009), 1700000999);
+
+    LoginStatsWriterStats stats = writer.stats();
+    EXPECT_EQ(stats.recorded, 1000u);
+    EXPECT_EQ(stats.written, 10u);
+    EXPECT_EQ(stats.pending, 0u);
+}
+
+TEST_F(LoginStatsWriterTest, FullBatchFlushesBeforeTheInterval) {
+    LoginStatsWriter writer(store_, NEVER, 50, SHUTDOWN);
+    for (u32 i = 0; i < 120; ++i) writer.record(2000 + i, 1700000000);
+
+    ASSERT_TRUE(eventually([&] { return store_->total_logins() == 120; }));
+    EXPECT_LE(store_->largest_batch(), 50u);
+    EXPECT_TRUE(writer.stop());
+}
+
+TEST_F(LoginStatsWriterTest, FailedBatchIsKeptAndRetried) {
+    LoginStatsWriter writer(store_, std::chrono::milliseconds(10), 1000, SHUTDOWN);
+    store_->set_down(true);
+    for (u32 i = 0; i < 60; ++i) writer.record(3000 + i, 1700000000);
+
+    ASSERT_TRUE(eventually([&] { return writer.stats().failures >= 2; }));
+    ASSERT_TRUE(eventually([&] { return writer.stats().pending == 60; }));
+    EXPECT_EQ(store_->total_logins(), 0u);
+
+    // Merged into the kept entry once the store is back
+    writer.record(3000, 1700000100);
+
+    store_->set_down(false);
+    ASSERT_TRUE(eventually([&] { return store_->total_logins() == 61; }));
+    EXPECT_EQ(store_->logins(3000), 2u);
+    EXPECT_EQ(store_->last_login(3000), 1700000100);
+    EXPECT_TRUE(writer.stop());
+}
+
+TEST_F(LoginStatsWriterTest, StopReportsAFinalWriteThatFailed) {
+    LoginStatsWriter writer(store_, NEVER, 1000, std::chrono::milliseconds(250));
+    writer.record(1, 1700000000);
+    store_->set_down(true);
+    EXPECT_FALSE(writer.stop());
+    EXPECT_EQ(store_->total_logins(), 0u);
+    EXPECT_GE(writer.stats().failures, 2u);
+    EXPECT_EQ(writer.stats().pending, 1u);
+}
+
+TEST_F(LoginStatsWriterTest, StopRetriesUntilTheStoreIsBack) {
+    LoginStatsWriter writer(store_, NEVER, 1000, SHUTDOWN);
+    for (u32 i = 0; i < 20; ++i) writer.record(4000 + i, 1700000000);
+    store_->set_down(true);
+
+    std::thread restore([this] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        store_->set_down(false);
+    });
+    EXPECT_TRUE(writer.stop());
+    restore.join();
+    EXPECT_EQ(store_->total_logins(), 20u);
+    EXPECT_EQ(writer.stats().pending, 0u);
+}
+
+TEST_F(LoginStatsWriterTest, StopWithNothingPendingWritesNothing) {
+    LoginStatsWriter writer(store_, NEVER, 1000, SHUTDOWN);
+    EXPECT_TRUE(writer.stop());
+    EXPECT_EQ(store_->batches(), 0);
+}
+
+} // namespace
+} // namespace swganh
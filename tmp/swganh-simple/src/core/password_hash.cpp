@@ -0,0 +1,66 @@
+// File: src/core/password_hash.cpp
+#include "password_hash.hpp"
+
+#include <crypt.h>
+#include <openssl/crypto.h>
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+
+namespace swganh {
+
+namespace {
+
+// crypt_rn needs the password NUL-terminated
+bool to_c_string(std::string_view password, std::string& out) {
+    if (password.find('\0') != std::string_view::npos) return false;
+    out.assign(password);
+    return true;
+}
+
+} // namespace
+
+std::string PasswordHash::create(std::string_view password, int cost) {
+    std::string key;
+    if (!to_c_string(password, key)) {
+        throw std::runtime_error("password contains NUL");
+    }
+
+    char setting[CRYPT_GENSALT_OUTPUT_SIZE];
+    if (!crypt_gensalt_rn("$2b$", static_cast<unsigned long>(std::clamp(cost, MIN_COST, MAX_COST)),
+                          nullptr, 0, setting, sizeof(setting))) {
+        throw std::runtime_error("crypt_gensalt_rn failed");
+    }
+
+    // crypt_data is ~32 KB; keep it off the worker's stack
+    auto data = std::make_unique<crypt_data>();
+    const char* hash = crypt_rn(key.c_str(), setting, data.get(), sizeof(crypt_data));
+    if (!hash || hash[0] == '*') {
+        throw std::runtime_error("crypt_rn failed");
+    }
+    return hash;
+}
+
+bool PasswordHash::verify(std::string_view password, const std::string& hash) {
+    std::string key;
+    if (cost_of(hash) == 0 || !to_c_string(password, key)) return false;
+
+    auto data = std::make_unique<crypt_data>();
+    const char* computed = crypt_rn(key.c_str(), hash.c_str(), data.get(), sizeof(crypt_data));
+    if (!computed || computed[0] == '*') return false;
+
+    size_t length = std::strlen(computed);
+    return length == hash.size() && CRYPTO_memcmp(computed, hash.data(), length) == 0;
+}
+
+int PasswordHash::cost_of(std::string_view hash) {
+    // $2a$NN$ / $2b$NN$ / $2y$NN$ followed by 53 characters of salt and hash
+    if (hash.size() != 60 || hash[0] != '$' || hash[1] != '2' || hash[3] != '$' || hash[6] != '$') return 0;
+    if (hash[2] != 'a' && hash[2] != 'b' && hash[2] != 'y') return 0;
+    if (hash[4] < '0' || hash[4] > '9' || hash[5] < '0' || hash[5] > '9') return 0;
+    int cost = (hash[4] - '0') * 10 + (hash[5] - '0');
+    return cost >= MIN_COST && cost <= MAX_COST ? cost : 0;
+}
+
+} // namespace swganh
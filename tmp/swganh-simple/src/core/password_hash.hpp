@@ -0,0 +1,30 @@
+// File: src/core/password_hash.hpp
+#pragma once
+
+#include <string>
+#include <string_view>
+
+namespace swganh {
+
+// bcrypt through libxcrypt's crypt_rn, the same "$2a$"/"$2b$" strings that
+// pgcrypto's crypt(password, gen_salt('bf')) stores in account.accounts.
+// Every call costs 2^cost rounds of Blowfish key setup - milliseconds of CPU -
+// so call these from the auth pool, never from an IO thread. Both are thread
+// safe. Only the first 72 bytes of a password count, as with any bcrypt.
+class PasswordHash {
+public:
+    static constexpr int MIN_COST = 4;
+    static constexpr int MAX_COST = 31;
+
+    // New salted hash; throws std::runtime_error if crypt fails
+    static std::string create(std::string_view password, int cost);
+
+    // Constant-time check of password against a stored hash. False for
+    // malformed hashes and for passwords containing NUL.
+    static bool verify(std::string_view password, const std::string& hash);
+
+    // Cost factor encoded in a bcrypt hash, or 0 if it is not one
+    static int cost_of(std::string_view hash);
+};
+
+} // namespace swganh
@@ -0,0 +1,334 @@
+// File: src/core/postgres_account_store.cpp
+#include "postgres_account_store.hpp"
+#include "logger.hpp"
+
+#include <libpq-fe.h>
+#include <cstdlib>
+
+namespace swganh {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct StatementText {
+    const char* name;
+    const char* sql;
+    int params;
+};
+
+// status: 0 = banned, 1 = active, 2 = suspended
+constexpr StatementText FIND_ACCOUNT_SQL = {
+    "find_account",
+    "SELECT station_id, password_hash, status, login_count, permissions "
+    "FROM account.accounts WHERE username = $1",
+    1
+};
+
+// email is required and unique; auto-created accounts get a placeholder
+constexpr StatementText CREATE_ACCOUNT_SQL = {
+    "create_account",
+    "INSERT INTO account.accounts (station_id, username, password_hash, email) "
+    "VALUES ($1, $2, $3, $2 || '@players.invalid') "
+    "ON CONFLICT (username) DO NOTHING RETURNING station_id",
+    3
+};
+
+// One row lock for the whole block; station_id is a signed INTEGER
+constexpr StatementText LEASE_ACCOUNT_IDS_SQL = {
+    "lease_account_ids",
+    "UPDATE account.id_blocks SET next_id = next_id + $1 "
+    "WHERE name = 'station_id' AND next_id + $1 <= 2147483648 "
+    "RETURNING next_id - $1",
+    1
+};
+
+// The whole batch travels as three parallel arrays, so it is one statement
+// and one round trip whatever its size. GREATEST skips a NULL last_login.
+constexpr StatementText UPDATE_LOGIN_STATS_SQL = {
+    "update_login_stats",
+    "UPDATE account.accounts AS a "
+    "SET login_count = COALESCE(a.login_count, 0) + u.logins, "
+    "last_login = GREATEST(a.last_login, to_timestamp(u.last_login)) "
+    "FROM unnest($1::integer[], $2::integer[], $3::bigint[]) AS u(station_id, logins, last_login) "
+    "WHERE a.station_id = u.station_id",
+    3
+};
+
+// Single-row mode hands rows over as they arrive instead of buffering the table
+constexpr const char* SCAN_USERNAMES_SQL = "SELECT username FROM account.accounts";
+
+// Same leading columns as find_account, so parse_account reads both
+constexpr const char* SCAN_CHANGED_SQL =
+    "SELECT station_id, password_hash, status, login_count, permissions, username "
+    "FROM account.accounts WHERE updated_at >= to_timestamp($1)";
+
+constexpr const char* CLOCK_SQL = "SELECT extract(epoch FROM now())::bigint";
+
+const char* STATEMENT_NAMES[] = {"find_account", "create_account", "update_login_stats", "scan_usernames",
+                                 "scan_changed_since", "lease_account_ids"};
+
+struct ResultDeleter {
+    void operator()(PGresult* result) const { PQclear(result); }
+};
+using Result = std::unique_ptr<PGresult, ResultDeleter>;
+
+u64 elapsed_ns(Clock::time_point since) {
+    return static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - since).count());
+}
+
+u32 to_u32(const char* text) {
+    return static_cast<u32>(std::strtoul(text, nullptr, 10));
+}
+
+std::string error_of(PGconn* conn) {
+    std::string message = PQerrorMessage(conn);
+    while (!message.empty() && (message.back() == '\n' || message.back() == ' ')) message.pop_back();
+    return message;
+}
+
+std::optional<StoredAccount> parse_account(PGresult* result, std::string_view username) {
+    if (PQntuples(result) == 0) return std::nullopt;
+    StoredAccount account;
+    account.account_id = to_u32(PQgetvalue(result, 0, 0));
+    account.username = std::string(username);
+    account.password_hash = PQgetvalue(result, 0, 1);
+    account.is_active = to_u32(PQgetvalue(result, 0, 2)) == 1;
+    account.login_count = to_u32(PQgetvalue(result, 0, 3));
+    account.permissions = to_u32(PQgetvalue(result, 0, 4));
+    return account;
+}
+
+} // namespace
+
+PostgresAccountStore::PostgresAccountStore(const std::string& conninfo, u32 pool_size,
+                                           std::chrono::milliseconds acquire_timeout)
+    : conninfo_(conninfo), acquire_timeout_(acquire_timeout) {
+    if (pool_size == 0) pool_size = 1;
+
+    for (u32 i = 0; i < pool_size; ++i) {
+        auto connection = std::make_unique<Connection>();
+        connection->conn = PQconnectdb(conninfo_.c_str());
+        if (PQstatus(connection->conn) != CONNECTION_OK) {
+            std::string error = error_of(connection->conn);
+            PQfinish(connection->conn);
+            for (auto& opened : connections_) PQfinish(opened->conn);
+            throw AccountStoreError("PostgreSQL connect failed: " + error);
+        }
+        ensure_ready(*connection);
+        idle_.push_back(connection.get());
+        connections_.push_back(std::move(connection));
+    }
+
+    LOG_INFO_F("Account store: {} PostgreSQL connections to {}", pool_size,
+               PQdb(connections_.front()->conn));
+}
+
+PostgresAccountStore::~PostgresAccountStore() {
+    for (auto& connection : connections_) {
+        PQfinish(connection->conn);
+    }
+}
+
+PostgresAccountStore::Lease PostgresAccountStore::acquire() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!available_.wait_for(lock, acquire_timeout_, [this]() { return !idle_.empty(); })) {
+        throw AccountStoreError("no database connection free within the timeout");
+    }
+    Connection* connection = idle_.back();
+    idle_.pop_back();
+    lock.unlock();
+
+    try {
+        ensure_ready(*connection);
+    } catch (...) {
+        release(*connection);
+        throw;
+    }
+    return Lease(*this, *connection);
+}
+
+void PostgresAccountStore::release(Connection& connection) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        idle_.push_back(&connection);
+    }
+    available_.notify_one();
+}
+
+void PostgresAccountStore::ensure_ready(Connection& connection) {
+    if (PQstatus(connection.conn) != CONNECTION_OK) {
+        LOG_WARNING("Account store: connection lost, reconnecting");
+        PQreset(connection.conn);
+        connection.prepared = false;
+        if (PQstatus(connection.conn) != CONNECTION_OK) {
+            throw AccountStoreError("PostgreSQL reconnect failed: " + error_of(connection.conn));
+        }
+    }
+    if (connection.prepared) return;
+
+    for (const StatementText& statement : {FIND_ACCOUNT_SQL, CREATE_ACCOUNT_SQL, UPDATE_LOGIN_STATS_SQL,
+                                            LEASE_ACCOUNT_IDS_SQL}) {
+        Result result(PQprepare(connection.conn, statement.name, statement.sql, statement.params, nullptr));
+        if (PQresultStatus(result.get()) != PGRES_COMMAND_OK) {
+            throw AccountStoreError(std::string("prepare ") + statement.name + " failed: " + error_of(connection.conn));
+        }
+    }
+    connection.prepared = true;
+}
+
+std::optional<StoredAccount> PostgresAccountStore::find_account(std::string_view username) {
+    Lease connection = acquire();
+    std::string name(username);
+    const char* params[] = {name.c_str()};
+
+    Clock::time_point started = Clock::now();
+    Result result(PQexecPrepared(connection->conn, FIND_ACCOUNT_SQL.name, 1, params, nullptr, nullptr, 0));
+    connection->latency[FIND_ACCOUNT].record(elapsed_ns(started));
+
+    if (PQresultStatus(result.get()) != PGRES_TUPLES_OK) {
+        throw AccountStoreError("find_account failed: " + error_of(connection->conn));
+    }
+    return parse_account(result.get(), username);
+}
+
+bool PostgresAccountStore::create_account(u32 account_id, std::string_view username, std::string_view password_hash) {
+    Lease connection = acquire();
+    std::string id = std::to_string(account_id);
+    std::string name(username);
+    std::string hash(password_hash);
+    const char* params[] = {id.c_str(), name.c_str(), hash.c_str()};
+
+    Clock::time_point started = Clock::now();
+    Result result(PQexecPrepared(connection->conn, CREATE_ACCOUNT_SQL.name, 3, params, nullptr, nullptr, 0));
+    connection->latency[CREATE_ACCOUNT].record(elapsed_ns(started));
+
+    if (PQresultStatus(result.get()) != PGRES_TUPLES_OK) {
+        throw AccountStoreError("create_account failed: " + error_of(connection->conn));
+    }
+    return PQntuples(result.get()) > 0;
+}
+
+IdBlock PostgresAccountStore::lease_account_ids(u32 count) {
+    Lease connection = acquire();
+    std::string amount = std::to_string(count);
+    const char* params[] = {amount.c_str()};
+
+    Clock::time_point started = Clock::now();
+    Result result(PQexecPrepared(connection->conn, LEASE_ACCOUNT_IDS_SQL.name, 1, params, nullptr, nullptr, 0));
+    connection->latency[LEASE_ACCOUNT_IDS].record(elapsed_ns(started));
+
+    if (PQresultStatus(result.get()) != PGRES_TUPLES_OK) {
+        throw AccountStoreError("lease_account_ids failed: " + error_of(connection->conn));
+    }
+    if (PQntuples(result.get()) == 0) {
+        throw AccountStoreError("lease_account_ids failed: station ids exhausted or account.id_blocks not seeded");
+    }
+    return IdBlock{to_u32(PQgetvalue(result.get(), 0, 0)), count};
+}
+
+void PostgresAccountStore::stream_rows(PGconn* conn, const char* what, const std::function<void(PGresult*)>& row) {
+    if (PQsetSingleRowMode(conn) != 1) {
+        throw AccountStoreError(std::string(what) + " failed: " + error_of(conn));
+    }
+
+    // Drain every result even after an error so the connection is reusable
+    std::string error;
+    while (Result result{PQgetResult(conn)}) {
+        ExecStatusType status = PQresultStatus(result.get());
+        if (status == PGRES_SINGLE_TUPLE) {
+            if (error.empty()) row(result.get());
+        } else if (status != PGRES_TUPLES_OK && error.empty()) {
+            error = error_of(conn);
+        }
+    }
+    if (!error.empty()) {
+        throw AccountStoreError(std::string(what) + " failed: " + error);
+    }
+}
+
+void PostgresAccountStore::scan_usernames(const std::function<void(std::string_view)>& visit) {
+    Lease connection = acquire();
+    PGconn* conn = connection->conn;
+
+    Clock::time_point started = Clock::now();
+    if (PQsendQuery(conn, SCAN_USERNAMES_SQL) != 1) {
+        throw AccountStoreError("scan_usernames failed: " + error_of(conn));
+    }
+    stream_rows(conn, "scan_usernames", [&](PGresult* result) {
+        visit(std::string_view(PQgetvalue(result, 0, 0), static_cast<size_t>(PQgetlength(result, 0, 0))));
+    });
+    connection->latency[SCAN_USERNAMES].record(elapsed_ns(started));
+}
+
+i64 PostgresAccountStore::scan_changed_since(i64 since, const std::function<void(const StoredAccount&)>& visit) {
+    Lease connection = acquire();
+    PGconn* conn = connection->conn;
+
+    // The clock is read first: a row changed during the scan is either seen
+    // now or changed at or after the returned time
+    Clock::time_point started = Clock::now();
+    Result clock(PQexec(conn, CLOCK_SQL));
+    if (PQresultStatus(clock.get()) != PGRES_TUPLES_OK || PQntuples(clock.get()) != 1) {
+        throw AccountStoreError("reading the database clock failed: " + error_of(conn));
+    }
+    i64 as_of = std::strtoll(PQgetvalue(clock.get(), 0, 0), nullptr, 10);
+
+    std::string since_text = std::to_string(since);
+    const char* params[] = {since_text.c_str()};
+    if (PQsendQueryParams(conn, SCAN_CHANGED_SQL, 1, nullptr, params, nullptr, nullptr, 0) != 1) {
+        throw AccountStoreError("scan_changed_since failed: " + error_of(conn));
+    }
+    stream_rows(conn, "scan_changed_since", [&](PGresult* result) {
+        if (auto account = parse_account(result, PQgetvalue(result, 0, 5))) visit(*account);
+    });
+    connection->latency[SCAN_CHANGED].record(elapsed_ns(started));
+    return as_of;
+}
+
+void PostgresAccountStore::update_login_stats(std::span<const LoginStatsUpdate> updates) {
+    if (updates.empty()) return;
+
+    // Array literals, e.g. {1000,1001}
+    std::string ids = "{", logins = "{", last_logins = "{";
+    for (const LoginStatsUpdate& update : updates) {
+        if (ids.size() > 1) {
+            ids += ',';
+            logins += ',';
+            last_logins += ',';
+        }
+        ids += std::to_string(update.account_id);
+        logins += std::to_string(update.logins);
+        last_logins += std::to_string(update.last_login);
+    }
+    ids += '}';
+    logins += '}';
+    last_logins += '}';
+    const char* params[] = {ids.c_str(), logins.c_str(), last_logins.c_str()};
+
+    Lease connection = acquire();
+    Clock::time_point started = Clock::now();
+    Result result(PQexecPrepared(connection->conn, UPDATE_LOGIN_STATS_SQL.name, 3, params, nullptr, nullptr, 0));
+    connection->latency[UPDATE_LOGIN_STATS].record(elapsed_ns(started));
+
+    if (PQresultStatus(result.get()) != PGRES_COMMAND_OK) {
+        throw AccountStoreError("update_login_stats failed: " + error_of(connection->conn));
+    }
+}
+
+void PostgresAccountStore::log_stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    LOG_INFO_F("Account store: {} connections, {} idle", connections_.size(), idle_.size());
+    for (size_t statement = 0; statement < STATEMENT_COUNT; ++statement) {
+        std::vector<u64> totals;
+        for (const auto& connection : connections_) {
+            connection->latency[statement].accumulate(totals);
+        }
+        LatencySnapshot s = LatencyHistogram::summarize(totals);
+        if (s.count == 0) continue;
+        LOG_INFO_F("Account store {}: {} queries, p50 {} ns, p99 {} ns, max {} ns",
+                   STATEMENT_NAMES[statement], s.count, s.p50_ns, s.p99_ns, s.max_ns);
+    }
+}
+
+} // namespace swganh
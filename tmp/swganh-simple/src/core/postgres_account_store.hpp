@@ -0,0 +1,96 @@
+// File: src/core/postgres_account_store.hpp
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "account_store.hpp"
+#include "latency_histogram.hpp"
+
+typedef struct pg_conn PGconn;
+typedef struct pg_result PGresult;
+
+namespace swganh {
+
+// AccountStore over libpq. A fixed pool of connections is opened up front;
+// each prepares its statements once. Latency is recorded per statement and reported by log_stats().
+//
+// Expects account.accounts with the station_id and permissions columns
+// added by data/sql/02-account-station-id.sql, the updated_at change
+// tracking from 03-account-updated-at.sql and the id counter from
+// 04-account-id-blocks.sql.
+class PostgresAccountStore : public AccountStore {
+public:
+    // conninfo is anything PQconnectdb accepts (key=value or postgresql:// URI).
+    // Throws AccountStoreError if no connection can be opened.
+    PostgresAccountStore(const std::string& conninfo, u32 pool_size,
+                         std::chrono::milliseconds acquire_timeout = std::chrono::seconds(30));
+    ~PostgresAccountStore() override;
+
+    PostgresAccountStore(const PostgresAccountStore&) = delete;
+    PostgresAccountStore& operator=(const PostgresAccountStore&) = delete;
+
+    std::optional<StoredAccount> find_account(std::string_view username) override;
+    bool create_account(u32 account_id, std::string_view username, std::string_view password_hash) override;
+    IdBlock lease_account_ids(u32 count) override;
+    void scan_usernames(const std::function<void(std::string_view)>& visit) override;
+    i64 scan_changed_since(i64 since, const std::function<void(const StoredAccount&)>& visit) override;
+    void update_login_stats(std::span<const LoginStatsUpdate> updates) override;
+
+    void log_stats() const override;
+
+private:
+    enum Statement : size_t {
+        FIND_ACCOUNT,
+        CREATE_ACCOUNT,
+        UPDATE_LOGIN_STATS,
+        SCAN_USERNAMES,
+        SCAN_CHANGED,
+        LEASE_ACCOUNT_IDS,
+        STATEMENT_COUNT
+    };
+
+    // A connection is used by one thread at a time, so it can own the histograms
+    struct Connection {
+        PGconn* conn = nullptr;
+        bool prepared = false;
+        std::array<LatencyHistogram, STATEMENT_COUNT> latency;
+    };
+
+    // Checked-out connection, returned to the pool on destruction
+    class Lease {
+    public:
+        Lease(PostgresAccountStore& store, Connection& connection) : store_(store), connection_(&connection) {}
+        ~Lease() { store_.release(*connection_); }
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+        Connection& operator*() const { return *connection_; }
+        Connection* operator->() const { return connection_; }
+    private:
+        PostgresAccountStore& store_;
+        Connection* connection_;
+    };
+
+    Lease acquire();
+    void release(Connection& connection);
+
+    // Streams a query's rows one result at a time; throws after draining on error
+    void stream_rows(PGconn* conn, const char* what, const std::function<void(PGresult*)>& row);
+
+    // Reconnects a broken connection and prepares statements if needed
+    void ensure_ready(Connection& connection);
+
+    std::string conninfo_;
+    std::chrono::milliseconds acquire_timeout_;
+
+    std::vector<std::unique_ptr<Connection>> connections_;
+    mutable std::mutex mutex_;
+    std::condition_variable available_;
+    std::vector<Connection*> idle_;
+};
+
+} // namespace swganh
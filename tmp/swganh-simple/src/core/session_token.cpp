@@ -0,0 +1,131 @@
+// File: src/core/session_token.cpp
+#include "session_token.hpp"
+#include "config.hpp"
+#include "logger.hpp"
+
+#include <openssl/crypto.h>
+#include <openssl/rand.h>
+#include <algorithm>
+#include <stdexcept>
+
+namespace swganh {
+
+namespace {
+
+constexpr size_t MIN_KEY_SIZE = 32;
+
+void put_le(u8* out, u64 value, size_t bytes) {
+    for (size_t i = 0; i < bytes; ++i) {
+        out[i] = static_cast<u8>(value >> (8 * i));
+    }
+}
+
+u64 get_le(const u8* in, size_t bytes) {
+    u64 value = 0;
+    for (size_t i = 0; i < bytes; ++i) {
+        value |= static_cast<u64>(in[i]) << (8 * i);
+    }
+    return value;
+}
+
+std::vector<u8> parse_hex(std::string_view text) {
+    auto nibble = [](char c) -> int {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    };
+
+    std::vector<u8> bytes;
+    if (text.size() % 2 != 0) return bytes;
+    for (size_t i = 0; i < text.size(); i += 2) {
+        int high = nibble(text[i]);
+        int low = nibble(text[i + 1]);
+        if (high < 0 || low < 0) return {};
+        bytes.push_back(static_cast<u8>((high << 4) | low));
+    }
+    return bytes;
+}
+
+} // namespace
+
+SessionTokens::SessionTokens() {
+    Config& config = Config::instance();
+    lifetime_ = std::chrono::seconds(config.get_int("session_token_lifetime", 300));
+
+    std::vector<u8> key = parse_hex(config.get("session_token_key"));
+    configured_key_ = key.size() >= MIN_KEY_SIZE;
+    if (!configured_key_) {
+        // Fine for a lone dev server; zone servers need the same configured key
+        LOG_WARNING("session_token_key missing or shorter than 32 bytes - using a random key");
+        key.resize(MIN_KEY_SIZE);
+        if (RAND_bytes(key.data(), static_cast<int>(key.size())) != 1) {
+            throw std::runtime_error("RAND_bytes failed");
+        }
+    }
+    set_key(std::move(key));
+}
+
+void SessionTokens::set_key(std::vector<u8> key, u8 key_id) {
+    mac_ = std::make_unique<HmacSha256>(key);
+    key_id_ = key_id;
+}
+
+u64 SessionTokens::unix_now() {
+    return static_cast<u64>(std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+void SessionTokens::sign(const u8* body, u8* mac) const {
+    HmacSha256::Digest digest = mac_->compute(std::span<const u8>(body, BODY_SIZE));
+    std::copy(digest.begin(), digest.begin() + MAC_SIZE, mac);
+}
+
+SessionTokens::Token SessionTokens::issue(u32 account_id, u32 permissions) const {
+    return issue(account_id, permissions, unix_now() + static_cast<u64>(lifetime_.count()));
+}
+
+SessionTokens::Token SessionTokens::issue(u32 account_id, u32 permissions, u64 expires_at) const {
+    Token token{};
+    u8* out = token.data();
+    out[0] = VERSION;
+    out[1] = key_id_;
+    put_le(out + 2, account_id, 4);
+    put_le(out + 6, permissions, 4);
+    put_le(out + 10, expires_at, 8);
+
+    // Nonce keeps two tokens for the same account and second distinct
+    if (RAND_bytes(out + 18, 8) != 1) {
+        throw std::runtime_error("RAND_bytes failed");
+    }
+
+    sign(out, out + BODY_SIZE);
+    return token;
+}
+
+std::optional<SessionClaims> SessionTokens::verify(std::span<const u8> token) const {
+    return verify(token, unix_now());
+}
+
+std::optional<SessionClaims> SessionTokens::verify(std::span<const u8> token, u64 now) const {
+    if (token.size() != TOKEN_SIZE || token[0] != VERSION || token[1] != key_id_) {
+        return std::nullopt;
+    }
+
+    u8 expected[MAC_SIZE];
+    sign(token.data(), expected);
+    if (CRYPTO_memcmp(expected, token.data() + BODY_SIZE, MAC_SIZE) != 0) {
+        return std::nullopt;
+    }
+
+    SessionClaims claims;
+    claims.account_id = static_cast<u32>(get_le(token.data() + 2, 4));
+    claims.permissions = static_cast<u32>(get_le(token.data() + 6, 4));
+    claims.expires_at = get_le(token.data() + 10, 8);
+    if (claims.expires_at <= now) {
+        return std::nullopt;
+    }
+    return claims;
+}
+
+} // namespace swganh
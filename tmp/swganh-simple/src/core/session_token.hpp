@@ -0,0 +1,73 @@
+// File: src/core/session_token.hpp
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+#include "types.hpp"
+#include "hmac.hpp"
+
+namespace swganh {
+
+struct SessionClaims {
+    u32 account_id = 0;
+    u32 permissions = 0;
+    u64 expires_at = 0;  // Unix seconds
+};
+
+// Self-contained session tokens. The login server signs the account id,
+// permissions and expiry with HMAC-SHA256 under a key shared with the zone
+// servers, which check the signature and expiry locally instead of looking
+// the session up in the database.
+//
+// Layout (42 bytes, little-endian):
+//   u8 version, u8 key id, u32 account id, u32 permissions,
+//   u64 expires at, u64 nonce, 16-byte truncated HMAC of the preceding bytes
+class SessionTokens {
+public:
+    static constexpr u8 VERSION = 1;
+    static constexpr size_t MAC_SIZE = 16;
+    static constexpr size_t BODY_SIZE = 1 + 1 + 4 + 4 + 8 + 8;
+    static constexpr size_t TOKEN_SIZE = BODY_SIZE + MAC_SIZE;
+
+    using Token = std::array<u8, TOKEN_SIZE>;
+
+    // Keyed from Config: session_token_key (hex) and session_token_lifetime
+    static SessionTokens& instance() {
+        static SessionTokens inst;
+        return inst;
+    }
+
+    Token issue(u32 account_id, u32 permissions) const;
+    Token issue(u32 account_id, u32 permissions, u64 expires_at) const;
+
+    // Claims if the token is well formed, signed with our key and unexpired
+    std::optional<SessionClaims> verify(std::span<const u8> token) const;
+    std::optional<SessionClaims> verify(std::span<const u8> token, u64 now) const;
+
+    // Replace the signing key (rotation); not synchronized with issue/verify,
+    // so call it before serving traffic
+    void set_key(std::vector<u8> key, u8 key_id = 0);
+
+    static u64 unix_now();
+
+    // False if session_token_key was missing or too short and a random key
+    // is in use; tokens can then only be verified by this process
+    bool has_configured_key() const { return configured_key_; }
+
+private:
+    SessionTokens();
+
+    void sign(const u8* body, u8* mac) const;
+
+    std::unique_ptr<HmacSha256> mac_;
+    u8 key_id_ = 0;
+    bool configured_key_ = false;
+    std::chrono::seconds lifetime_{300};
+};
+
+} // namespace swganh
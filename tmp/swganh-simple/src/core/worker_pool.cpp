@@ -0,0 +1,136 @@
+// File: src/core/worker_pool.cpp
+#include "worker_pool.hpp"
+#include "logger.hpp"
+
+namespace swganh {
+
+WorkerPool::WorkerPool(std::string name, u32 thread_count, size_t capacity)
+    : name_(std::move(name)), thread_count_(thread_count > 0 ? thread_count : 1),
+      capacity_(capacity > 0 ? capacity : 1) {
+}
+
+WorkerPool::~WorkerPool() {
+    stop();
+}
+
+void WorkerPool::start() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_) return;
+    running_ = true;
+    started_at_ = Clock::now();
+
+    for (u32 i = 0; i < thread_count_; ++i) {
+        auto thread = std::make_unique<Thread>();
+        Thread* self = thread.get();
+        self->thread = std::thread([this, self]() { run(*self); });
+        threads_.push_back(std::move(thread));
+    }
+
+    LOG_INFO_F("{} pool started: {} threads, queue capacity {}", name_, thread_count_, capacity_);
+}
+
+void WorkerPool::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_) return;
+        running_ = false;
+    }
+    ready_.notify_all();
+
+    for (auto& thread : threads_) {
+        if (thread->thread.joinable()) {
+            thread->thread.join();
+        }
+    }
+
+    log_stats();
+}
+
+bool WorkerPool::try_submit(Task task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_ || queue_.size() >= capacity_) {
+            ++rejected_;
+            return false;
+        }
+
+        queue_.push_back(Item{std::move(task), Clock::now()});
+        ++submitted_;
+        if (queue_.size() > max_queue_depth_) max_queue_depth_ = queue_.size();
+    }
+    ready_.notify_one();
+    return true;
+}
+
+void WorkerPool::run(Thread& self) {
+    for (;;) {
+        Item item;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            ready_.wait(lock, [this]() { return !queue_.empty() || !running_; });
+
+            // Drain before exiting so accepted work always gets an answer
+            if (queue_.empty()) return;
+            item = std::move(queue_.front());
+            queue_.pop_front();
+        }
+
+        Clock::time_point started = Clock::now();
+        self.wait.record(static_cast<u64>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(started - item.queued_at).count()));
+
+        try {
+            item.task();
+        } catch (const std::exception& e) {
+            LOG_ERROR_F("{} task failed: {}", name_, e.what());
+        }
+
+        self.service.record(static_cast<u64>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - started).count()));
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++completed_;
+    }
+}
+
+size_t WorkerPool::queue_depth() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_.size();
+}
+
+WorkerPoolStats WorkerPool::stats() const {
+    WorkerPoolStats result;
+    std::vector<u64> wait_totals;
+    std::vector<u64> service_totals;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    result.queue_depth = queue_.size();
+    result.max_queue_depth = max_queue_depth_;
+    result.submitted = submitted_;
+    result.rejected = rejected_;
+    result.completed = completed_;
+    double uptime = std::chrono::duration<double>(Clock::now() - started_at_).count();
+    if (uptime > 0) result.completed_per_sec = static_cast<double>(completed_) / uptime;
+
+    for (const auto& thread : threads_) {
+        thread->wait.accumulate(wait_totals);
+        thread->service.accumulate(service_totals);
+    }
+    result.wait = LatencyHistogram::summarize(wait_totals);
+    result.service = LatencyHistogram::summarize(service_totals);
+    return result;
+}
+
+void WorkerPool::log_stats() const {
+    WorkerPoolStats s = stats();
+    LOG_INFO_F("{} pool: {} completed ({}/s), {} rejected, queue {} (max {})",
+               name_, s.completed, s.completed_per_sec, s.rejected,
+               s.queue_depth, s.max_queue_depth);
+    if (s.completed > 0) {
+        LOG_INFO_F("{} pool wait: p50 {} ns, p99 {} ns, max {} ns; service: p50 {} ns, p99 {} ns, max {} ns",
+                   name_, s.wait.p50_ns, s.wait.p99_ns, s.wait.max_ns,
+                   s.service.p50_ns, s.service.p99_ns, s.service.max_ns);
+    }
+}
+
+} // namespace swganh
@@ -0,0 +1,90 @@
+// File: src/core/worker_pool.hpp
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "types.hpp"
+#include "latency_histogram.hpp"
+
+namespace swganh {
+
+struct WorkerPoolStats {
+    u64 queue_depth = 0;
+    u64 max_queue_depth = 0;
+    u64 submitted = 0;
+    u64 rejected = 0;        // Queue was full or the pool was stopped
+    u64 completed = 0;
+    double completed_per_sec = 0;  // Since start
+    LatencySnapshot wait;     // Submit to start of execution
+    LatencySnapshot service;  // Execution time
+};
+
+// Fixed set of threads draining a bounded FIFO. Blocking work (password
+// hashing, database round trips) goes here so it never stalls an IO thread;
+// callers post results back to their own executor. When the queue is full
+// try_submit refuses instead of letting latency grow without bound.
+class WorkerPool {
+public:
+    using Task = std::function<void()>;
+
+    WorkerPool(std::string name, u32 thread_count, size_t capacity);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    void start();
+
+    // Runs whatever is still queued, then joins the threads
+    void stop();
+
+    // False when the queue is at capacity or the pool is not running
+    bool try_submit(Task task);
+
+    size_t queue_depth() const;
+    size_t capacity() const { return capacity_; }
+    WorkerPoolStats stats() const;
+    void log_stats() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Item {
+        Task task;
+        Clock::time_point queued_at;
+    };
+
+    // Histograms are written only by their own thread
+    struct Thread {
+        std::thread thread;
+        LatencyHistogram wait;
+        LatencyHistogram service;
+    };
+
+    void run(Thread& self);
+
+    std::string name_;
+    u32 thread_count_;
+    size_t capacity_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable ready_;
+    std::deque<Item> queue_;
+    bool running_ = false;
+    Clock::time_point started_at_;
+    u64 max_queue_depth_ = 0;
+    u64 submitted_ = 0;
+    u64 rejected_ = 0;
+    u64 completed_ = 0;
+
+    std::vector<std::unique_ptr<Thread>> threads_;
+};
+
+} // namespace swganh
@@ -0,0 +1,266 @@
+// File: src/network/message_schema.hpp
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstring>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../core/types.hpp"
+
+namespace swganh {
+namespace schema {
+
+// Declarative SWG message layouts.
+//
+// A message is a list of field codecs. From that one definition we get the
+// exact encoded size (so the output is allocated once), an encoder that the
+// compiler flattens into straight-line stores, and a bounds-checked decoder.
+// All integers are little-endian; strings are u16-length-prefixed ASCII.
+// Each codec also states MIN_SIZE, the fewest bytes any value can encode to,
+// which lets decoders reject impossible counts before allocating.
+//
+//   using ErrorMessage = Message<3, 0xB5ABF91A, AString, AString, U8>;
+//   auto bytes = ErrorMessage::encode({"type", "text", 0});
+
+template<typename T>
+struct Int {
+    using value_type = T;
+    static constexpr size_t MIN_SIZE = sizeof(T);
+
+    static constexpr size_t size(const T&) { return sizeof(T); }
+
+    static u8* write(u8* out, T value) {
+        using Unsigned = std::make_unsigned_t<T>;
+        Unsigned bits = static_cast<Unsigned>(value);
+        for (size_t i = 0; i < sizeof(T); ++i) {
+            out[i] = static_cast<u8>(bits >> (8 * i));
+        }
+        return out + sizeof(T);
+    }
+
+    static bool read(const u8*& in, const u8* end, T& value) {
+        if (static_cast<size_t>(end - in) < sizeof(T)) return false;
+        if constexpr (std::endian::native == std::endian::little) {
+            // One unaligned load instead of a byte-at-a-time shift chain
+            std::memcpy(&value, in, sizeof(T));
+        } else {
+            using Unsigned = std::make_unsigned_t<T>;
+            Unsigned bits = 0;
+            for (size_t i = 0; i < sizeof(T); ++i) {
+                bits |= static_cast<Unsigned>(static_cast<Unsigned>(in[i]) << (8 * i));
+            }
+            value = static_cast<T>(bits);
+        }
+        in += sizeof(T);
+        return true;
+    }
+};
+
+using U8 = Int<u8>;
+using U16 = Int<u16>;
+using U32 = Int<u32>;
+using U64 = Int<u64>;
+using I32 = Int<i32>;
+
+// u16 length + bytes. Decoded values borrow from the input buffer.
+// Longer values cannot be framed; they are cut to MAX_LENGTH so the length
+// prefix, size() and the bytes written always agree.
+struct AString {
+    using value_type = std::string_view;
+    static constexpr size_t MIN_SIZE = 2;
+    static constexpr size_t MAX_LENGTH = 0xFFFF;
+
+    static size_t size(std::string_view value) { return 2 + std::min(value.size(), MAX_LENGTH); }
+
+    static u8* write(u8* out, std::string_view value) {
+        assert(value.size() <= MAX_LENGTH && "AString longer than its u16 length prefix");
+        size_t length = std::min(value.size(), MAX_LENGTH);
+        out = U16::write(out, static_cast<u16>(length));
+        std::memcpy(out, value.data(), length);
+        return out + length;
+    }
+
+    static bool read(const u8*& in, const u8* end, std::string_view& value) {
+        u16 length;
+        if (!U16::read(in, end, length) || static_cast<size_t>(end - in) < length) return false;
+        value = std::string_view(reinterpret_cast<const char*>(in), length);
+        in += length;
+        return true;
+    }
+};
+
+// u32 length + raw bytes, borrowed on decode
+struct Blob {
+    using value_type = std::span<const u8>;
+    static constexpr size_t MIN_SIZE = 4;
+
+    static size_t size(std::span<const u8> value) { return 4 + value.size(); }
+
+    static u8* write(u8* out, std::span<const u8> value) {
+        out = U32::write(out, static_cast<u32>(value.size()));
+        if (!value.empty()) std::memcpy(out, value.data(), value.size());
+        return out + value.size();
+    }
+
+    static bool read(const u8*& in, const u8* end, std::span<const u8>& value) {
+        u32 length;
+        if (!U32::read(in, end, length) || static_cast<size_t>(end - in) < length) return false;
+        value = std::span<const u8>(in, length);
+        in += length;
+        return true;
+    }
+};
+
+// u32 character count + UTF-16LE code units. Decoding copies, since the
+// input gives no 2-byte alignment to borrow from.
+struct UString {
+    using value_type = std::u16string;
+    static constexpr size_t MIN_SIZE = 4;
+
+    static size_t size(const std::u16string& value) { return 4 + 2 * value.size(); }
+
+    static u8* write(u8* out, const std::u16string& value) {
+        out = U32::write(out, static_cast<u32>(value.size()));
+        for (char16_t c : value) out = U16::write(out, static_cast<u16>(c));
+        return out;
+    }
+
+    static bool read(const u8*& in, const u8* end, std::u16string& value) {
+        u32 length;
+        if (!U32::read(in, end, length) || static_cast<size_t>(end - in) / 2 < length) return false;
+        value.resize(length);
+        for (char16_t& c : value) {
+            u16 unit;
+            U16::read(in, end, unit);
+            c = static_cast<char16_t>(unit);
+        }
+        return true;
+    }
+};
+
+// Fixed sequence of fields stored as a tuple
+template<typename... Fields>
+struct Record {
+    using value_type = std::tuple<typename Fields::value_type...>;
+    static constexpr size_t MIN_SIZE = (Fields::MIN_SIZE + ... + 0);
+
+    static size_t size(const value_type& value) {
+        return size_impl(value, std::index_sequence_for<Fields...>{});
+    }
+
+    static u8* write(u8* out, const value_type& value) {
+        return write_impl(out, value, std::index_sequence_for<Fields...>{});
+    }
+
+    static bool read(const u8*& in, const u8* end, value_type& value) {
+        return read_impl(in, end, value, std::index_sequence_for<Fields...>{});
+    }
+
+private:
+    template<size_t... I>
+    static size_t size_impl(const value_type& value, std::index_sequence<I...>) {
+        return (size_t{0} + ... + Fields::size(std::get<I>(value)));
+    }
+
+    template<size_t... I>
+    static u8* write_impl(u8* out, const value_type& value, std::index_sequence<I...>) {
+        ((out = Fields::write(out, std::get<I>(value))), ...);
+        return out;
+    }
+
+    template<size_t... I>
+    static bool read_impl(const u8*& in, const u8* end, value_type& value, std::index_sequence<I...>) {
+        return (Fields::read(in, end, std::get<I>(value)) && ...);
+    }
+};
+
+// u32 count + that many records
+template<typename... Fields>
+struct List {
+    using record = Record<Fields...>;
+    using record_type = typename record::value_type;
+    using value_type = std::vector<record_type>;
+    static constexpr size_t MIN_SIZE = 4;
+
+    static size_t size(const value_type& value) {
+        size_t total = 4;
+        for (const auto& item : value) total += record::size(item);
+        return total;
+    }
+
+    static u8* write(u8* out, const value_type& value) {
+        out = U32::write(out, static_cast<u32>(value.size()));
+        for (const auto& item : value) out = record::write(out, item);
+        return out;
+    }
+
+    static bool read(const u8*& in, const u8* end, value_type& value) {
+        u32 count;
+        if (!U32::read(in, end, count)) return false;
+        value.clear();
+        // A count the remaining bytes cannot hold is a lie; check it before
+        // the resize so a small datagram cannot buy a large allocation
+        constexpr size_t record_min = record::MIN_SIZE > 0 ? record::MIN_SIZE : 1;
+        if (count > static_cast<size_t>(end - in) / record_min) return false;
+        value.resize(count);
+        for (auto& item : value) {
+            if (!record::read(in, end, item)) return false;
+        }
+        return true;
+    }
+};
+
+// SWG message: u16 operand count, u32 opcode, then the fields
+template<u16 OperandCount, u32 Opcode, typename... Fields>
+struct Message {
+    static constexpr u16 operand_count = OperandCount;
+    static constexpr u32 opcode = Opcode;
+    static constexpr size_t HEADER_SIZE = 6;
+
+    using body = Record<Fields...>;
+    using Values = typename body::value_type;
+
+    static size_t encoded_size(const Values& values) {
+        return HEADER_SIZE + body::size(values);
+    }
+
+    // Caller guarantees encoded_size(values) bytes at out
+    static u8* encode_into(u8* out, const Values& values) {
+        out = U16::write(out, OperandCount);
+        out = U32::write(out, Opcode);
+        return body::write(out, values);
+    }
+
+    static std::vector<u8> encode(const Values& values) {
+        std::vector<u8> out(encoded_size(values));
+        encode_into(out.data(), values);
+        return out;
+    }
+
+    // Full message including header; rejects other opcodes and operand counts
+    static bool decode(const u8* data, size_t size, Values& values) {
+        const u8* in = data;
+        const u8* end = data + size;
+        u16 operands;
+        u32 code;
+        if (!U16::read(in, end, operands) || operands != OperandCount) return false;
+        if (!U32::read(in, end, code) || code != Opcode) return false;
+        return body::read(in, end, values);
+    }
+
+    // Fields only, for callers that have already consumed the header
+    static bool decode_body(const u8* data, size_t size, Values& values) {
+        const u8* in = data;
+        return body::read(in, data + size, values);
+    }
+};
+
+} // namespace schema
+} // namespace swganh
@@ -0,0 +1,32 @@
+// File: src/network/reuseport_steering.hpp
+#pragma once
+
+#include "../core/types.hpp"
+
+namespace swganh {
+
+// CPU steering for a SO_REUSEPORT socket group.
+//
+// SOE only carries the connection ID in Session Request and Disconnect;
+// every data packet in between is identified by its sender alone. Steering
+// on the connection ID would therefore split a session across workers, so
+// the whole session is keyed on the source IPv4 address instead. That key
+// survives NAT port rebinding (the common case) where the kernel's default
+// 4-tuple hash does not.
+//
+// The same function is evaluated by the classic BPF program attached to the
+// group and by steering_index() below, so user space always knows which
+// worker owns a given client.
+
+// Worker index for a client address (host byte order)
+inline u32 steering_index(u32 source_address, u32 worker_count) {
+    if (worker_count <= 1) return 0;
+    return ((source_address * 0x9E3779B1u) >> 16) % worker_count;
+}
+
+// Attach the steering program to the reuseport group that socket_fd belongs
+// to. Sockets must have been bound in worker order. Returns false when the
+// platform or kernel does not support SO_ATTACH_REUSEPORT_CBPF.
+bool attach_reuseport_steering(int socket_fd, u32 worker_count);
+
+} // namespace swganh
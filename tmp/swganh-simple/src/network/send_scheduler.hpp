@@ -0,0 +1,88 @@
+// File: src/network/send_scheduler.hpp
+#pragma once
+
+#include <boost/asio.hpp>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <vector>
+#include "../core/types.hpp"
+
+namespace swganh {
+
+using boost::asio::ip::udp;
+
+// Outbound priority classes, drained strictly in this order
+enum class SendPriority : u8 {
+    RELIABLE_CONTROL = 0,    // Session setup, acks, disconnects
+    RELIABLE_DATA = 1,       // Game messages that must arrive
+    UNRELIABLE_POSITION = 2  // Movement updates - worthless once stale
+};
+
+struct OutboundPacket {
+    using Clock = std::chrono::steady_clock;
+
+    std::vector<u8> data;
+    udp::endpoint target;
+    SendPriority priority = SendPriority::RELIABLE_DATA;
+    Clock::time_point deadline = Clock::time_point::max();
+};
+
+// Per-worker send queue. Only ever touched from the owning worker's IO
+// thread, so nothing here is synchronised except the counters.
+class SendScheduler {
+public:
+    using Clock = OutboundPacket::Clock;
+
+    // How long an unreliable update may wait before it is dropped
+    static constexpr std::chrono::milliseconds DEFAULT_UNRELIABLE_DEADLINE{100};
+
+    void push(OutboundPacket packet) {
+        queue_for(packet.priority).push_back(std::move(packet));
+    }
+
+    // Put back a packet the socket refused so it keeps its place in line
+    void requeue(OutboundPacket packet) {
+        queue_for(packet.priority).push_front(std::move(packet));
+    }
+
+    // Next packet by priority. Unreliable packets past their deadline are
+    // discarded here rather than sent late.
+    bool pop(OutboundPacket& out, Clock::time_point now) {
+        for (auto& queue : queues_) {
+            while (!queue.empty()) {
+                OutboundPacket& front = queue.front();
+                if (front.deadline < now) {
+                    queue.pop_front();
+                    dropped_stale_.store(dropped_stale_.load(std::memory_order_relaxed) + 1,
+                                         std::memory_order_relaxed);
+                    continue;
+                }
+
+                out = std::move(front);
+                queue.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    size_t pending() const {
+        size_t total = 0;
+        for (const auto& queue : queues_) total += queue.size();
+        return total;
+    }
+
+    u64 dropped_stale() const { return dropped_stale_.load(std::memory_order_relaxed); }
+
+private:
+    std::deque<OutboundPacket>& queue_for(SendPriority priority) {
+        return queues_[static_cast<size_t>(priority)];
+    }
+
+    std::array<std::deque<OutboundPacket>, 3> queues_;
+    std::atomic<u64> dropped_stale_{0};
+};
+
+} // namespace swganh
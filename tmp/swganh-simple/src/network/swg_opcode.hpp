@@ -0,0 +1,125 @@
+// File: src/network/swg_opcode.hpp
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <string_view>
+#include "../core/types.hpp"
+
+namespace swganh {
+
+namespace detail {
+
+// CRC-32 (poly 0x04C11DB7, MSB first) lookup table, built by the compiler
+constexpr std::array<u32, 256> make_crc_table() {
+    std::array<u32, 256> table{};
+    for (u32 i = 0; i < 256; ++i) {
+        u32 crc = i << 24;
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc & 0x80000000u) ? (crc << 1) ^ 0x04C11DB7u : (crc << 1);
+        }
+        table[i] = crc;
+    }
+    return table;
+}
+
+inline constexpr std::array<u32, 256> CRC_TABLE = make_crc_table();
+
+constexpr u32 ceil_log2(std::size_t value) {
+    u32 bits = 0;
+    while ((std::size_t{1} << bits) < value) ++bits;
+    return bits;
+}
+
+} // namespace detail
+
+// SWG message opcodes are the CRC of the message name:
+//   constexpr u32 id = opcode("LoginClientId");  // 0x41131F96
+constexpr u32 opcode(std::string_view name) {
+    u32 crc = 0xFFFFFFFFu;
+    for (char c : name) {
+        crc = detail::CRC_TABLE[((crc >> 24) ^ static_cast<u8>(c)) & 0xFF] ^ (crc << 8);
+    }
+    return ~crc;
+}
+
+// Observed on the wire from the retail client
+static_assert(opcode("LoginClientId") == 0x41131F96);
+
+template<typename Handler>
+struct OpcodeRoute {
+    u32 opcode;
+    Handler handler;
+};
+
+// Opcode -> handler table with a perfect hash chosen at compile time.
+// A lookup is one multiply, one shift and one slot compare; unknown opcodes
+// land on a slot whose opcode does not match and get a null handler. The
+// table is at most half full, so a multiplier is found in a few tries.
+template<typename Handler, std::size_t N>
+class OpcodeRouter {
+public:
+    constexpr explicit OpcodeRouter(const std::array<OpcodeRoute<Handler>, N>& routes) {
+        for (std::size_t i = 0; i < N; ++i) {
+            for (std::size_t j = i + 1; j < N; ++j) {
+                if (routes[i].opcode == routes[j].opcode) throw std::logic_error("duplicate opcode route");
+            }
+        }
+
+        // Odd multipliers from a Weyl sequence until every route gets its own slot
+        u32 candidate = 0x9E3779B1u;
+        for (u32 attempt = 0; attempt < MAX_ATTEMPTS; ++attempt, candidate += 0x6A09E668u) {
+            u32 multiplier = candidate | 1u;
+            std::array<bool, SLOTS> used{};
+            bool collision = false;
+            for (const auto& route : routes) {
+                u32 index = slot_index(route.opcode, multiplier);
+                if (used[index]) {
+                    collision = true;
+                    break;
+                }
+                used[index] = true;
+            }
+            if (collision) continue;
+
+            multiplier_ = multiplier;
+            for (const auto& route : routes) {
+                slots_[slot_index(route.opcode, multiplier)] = Slot{route.opcode, route.handler};
+            }
+            return;
+        }
+        throw std::logic_error("no perfect hash for opcode routes");
+    }
+
+    // Null handler when the opcode has no route
+    constexpr Handler find(u32 opcode) const {
+        const Slot& slot = slots_[slot_index(opcode, multiplier_)];
+        return slot.opcode == opcode ? slot.handler : Handler{};
+    }
+
+private:
+    static constexpr u32 BITS = detail::ceil_log2(N) + 1;
+    static constexpr std::size_t SLOTS = std::size_t{1} << BITS;
+    static constexpr u32 MAX_ATTEMPTS = 1u << 16;
+
+    struct Slot {
+        u32 opcode = 0;
+        Handler handler{};
+    };
+
+    static constexpr u32 slot_index(u32 opcode, u32 multiplier) {
+        return static_cast<u32>(opcode * multiplier) >> (32 - BITS);
+    }
+
+    std::array<Slot, SLOTS> slots_{};
+    u32 multiplier_ = 0;
+};
+
+template<typename Handler, typename... Routes>
+constexpr OpcodeRouter<Handler, sizeof...(Routes)> make_opcode_router(Routes... routes) {
+    return OpcodeRouter<Handler, sizeof...(Routes)>(
+        std::array<OpcodeRoute<Handler>, sizeof...(Routes)>{routes...});
+}
+
+} // namespace swganh
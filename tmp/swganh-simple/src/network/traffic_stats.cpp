@@ -0,0 +1,227 @@
+// File: src/network/traffic_stats.cpp
+#include "traffic_stats.hpp"
+#include <cstdio>
+#include <map>
+#include <sstream>
+
+namespace swganh {
+
+namespace {
+
+// Single writer per shard, so a plain load/store pair is enough
+inline void bump(std::atomic<u64>& counter, u64 amount) {
+    counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+std::string hex(u32 value, int width) {
+    char buffer[16];
+    std::snprintf(buffer, sizeof(buffer), "0x%0*X", width, value);
+    return buffer;
+}
+
+void write_counters(std::ostringstream& out, const TrafficCounters& counters) {
+    out << "\"packets_in\":" << counters.packets_in
+        << ",\"bytes_in\":" << counters.bytes_in
+        << ",\"packets_out\":" << counters.packets_out
+        << ",\"bytes_out\":" << counters.bytes_out;
+}
+
+} // namespace
+
+void TrafficStats::Counters::add_in(std::size_t bytes) {
+    bump(packets_in, 1);
+    bump(bytes_in, bytes);
+}
+
+void TrafficStats::Counters::add_out(std::size_t bytes) {
+    bump(packets_out, 1);
+    bump(bytes_out, bytes);
+}
+
+TrafficCounters TrafficStats::Counters::load() const {
+    TrafficCounters result;
+    result.packets_in = packets_in.load(std::memory_order_relaxed);
+    result.bytes_in = bytes_in.load(std::memory_order_relaxed);
+    result.packets_out = packets_out.load(std::memory_order_relaxed);
+    result.bytes_out = bytes_out.load(std::memory_order_relaxed);
+    return result;
+}
+
+void TrafficStats::Counters::clear() {
+    packets_in.store(0, std::memory_order_relaxed);
+    bytes_in.store(0, std::memory_order_relaxed);
+    packets_out.store(0, std::memory_order_relaxed);
+    bytes_out.store(0, std::memory_order_relaxed);
+}
+
+TrafficStats::Shard& TrafficStats::local_shard() {
+    thread_local Shard* shard = nullptr;
+    if (!shard) {
+        // Once per thread; shards outlive their threads so counts are kept
+        auto created = std::make_unique<Shard>();
+        shard = created.get();
+        std::lock_guard<std::mutex> lock(shards_mutex_);
+        shards_.push_back(std::move(created));
+    }
+
+    u64 epoch = session_epoch_.load(std::memory_order_relaxed);
+    if (shard->session_epoch.load(std::memory_order_relaxed) != epoch) {
+        for (auto& slot : shard->sessions) {
+            slot.key.store(0, std::memory_order_relaxed);
+            slot.counters.clear();
+        }
+        shard->untracked_sessions.clear();
+        shard->session_epoch.store(epoch, std::memory_order_release);
+    }
+    return *shard;
+}
+
+u64 TrafficStats::session_key(const udp::endpoint& peer) {
+    if (!peer.address().is_v4()) return 0;
+    return (static_cast<u64>(peer.address().to_v4().to_uint()) << 16) | peer.port();
+}
+
+udp::endpoint TrafficStats::session_endpoint(u64 key) {
+    return udp::endpoint(boost::asio::ip::address_v4(static_cast<u32>(key >> 16)),
+                         static_cast<u16>(key & 0xFFFF));
+}
+
+TrafficStats::Counters& TrafficStats::session_counters(Shard& shard, const udp::endpoint& peer) {
+    u64 key = session_key(peer);
+    if (key == 0) return shard.untracked_sessions;
+
+    std::size_t index = static_cast<std::size_t>((key * 0x9E3779B97F4A7C15ull) >> 52) % SESSION_SLOTS;
+    for (std::size_t probe = 0; probe < MAX_PROBES; ++probe) {
+        auto& slot = shard.sessions[(index + probe) % SESSION_SLOTS];
+        u64 current = slot.key.load(std::memory_order_relaxed);
+        if (current == key) return slot.counters;
+        if (current == 0) {
+            // Publish the key after zeroed counters so readers never pair them wrongly
+            slot.key.store(key, std::memory_order_release);
+            return slot.counters;
+        }
+    }
+    return shard.untracked_sessions;
+}
+
+TrafficStats::Counters& TrafficStats::swg_counters(Shard& shard, u32 opcode) {
+    if (opcode == 0) return shard.untracked_opcodes;
+
+    std::size_t index = static_cast<std::size_t>((opcode * 0x9E3779B1u) >> 23) % SWG_OPCODE_SLOTS;
+    for (std::size_t probe = 0; probe < MAX_PROBES; ++probe) {
+        auto& slot = shard.swg_opcodes[(index + probe) % SWG_OPCODE_SLOTS];
+        u32 current = slot.key.load(std::memory_order_relaxed);
+        if (current == opcode) return slot.counters;
+        if (current == 0) {
+            slot.key.store(opcode, std::memory_order_release);
+            return slot.counters;
+        }
+    }
+    return shard.untracked_opcodes;
+}
+
+void TrafficStats::record_in(const udp::endpoint& peer, const u8* data, std::size_t size) {
+    Shard& shard = local_shard();
+    shard.total.add_in(size);
+    session_counters(shard, peer).add_in(size);
+
+    // SOE opcodes are big-endian 0x00NN; anything else lands in slot 0
+    u8 opcode = (size >= 2 && data[0] == 0) ? data[1] : 0;
+    shard.soe_opcodes[opcode].add_in(size);
+}
+
+void TrafficStats::record_out(const udp::endpoint& peer, const u8* data, std::size_t size) {
+    Shard& shard = local_shard();
+    shard.total.add_out(size);
+    session_counters(shard, peer).add_out(size);
+
+    u8 opcode = (size >= 2 && data[0] == 0) ? data[1] : 0;
+    shard.soe_opcodes[opcode].add_out(size);
+}
+
+void TrafficStats::record_swg_in(u32 opcode, std::size_t size) {
+    swg_counters(local_shard(), opcode).add_in(size);
+}
+
+void TrafficStats::record_swg_out(u32 opcode, std::size_t size) {
+    swg_counters(local_shard(), opcode).add_out(size);
+}
+
+TrafficSnapshot TrafficStats::snapshot() const {
+    TrafficSnapshot result;
+    std::map<u64, TrafficCounters> sessions;
+    std::map<u16, TrafficCounters> soe;
+    std::map<u32, TrafficCounters> swg;
+
+    u64 epoch = session_epoch_.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(shards_mutex_);
+    for (const auto& shard : shards_) {
+        // A shard that has not written since a reset still holds the old sessions
+        bool sessions_current = shard->session_epoch.load(std::memory_order_acquire) == epoch;
+        result.total += shard->total.load();
+        if (sessions_current) result.untracked_sessions += shard->untracked_sessions.load();
+        result.untracked_opcodes += shard->untracked_opcodes.load();
+
+        for (std::size_t i = 0; i < shard->soe_opcodes.size(); ++i) {
+            TrafficCounters counters = shard->soe_opcodes[i].load();
+            if (counters.packets_in || counters.packets_out) {
+                soe[static_cast<u16>(i)] += counters;
+            }
+        }
+
+        for (const auto& slot : shard->sessions) {
+            if (!sessions_current) break;
+            u64 key = slot.key.load(std::memory_order_acquire);
+            if (key != 0) sessions[key] += slot.counters.load();
+        }
+
+        for (const auto& slot : shard->swg_opcodes) {
+            u32 key = slot.key.load(std::memory_order_acquire);
+            if (key != 0) swg[key] += slot.counters.load();
+        }
+    }
+
+    for (const auto& [key, counters] : sessions) {
+        result.sessions.emplace_back(session_endpoint(key), counters);
+    }
+    result.soe_opcodes.assign(soe.begin(), soe.end());
+    result.swg_opcodes.assign(swg.begin(), swg.end());
+    return result;
+}
+
+std::string TrafficSnapshot::to_json() const {
+    std::ostringstream out;
+    out << "{\"total\":{";
+    write_counters(out, total);
+
+    out << "},\"sessions\":[";
+    for (std::size_t i = 0; i < sessions.size(); ++i) {
+        const auto& [peer, counters] = sessions[i];
+        out << (i ? "," : "") << "{\"peer\":\"" << peer.address().to_string() << ":" << peer.port() << "\",";
+        write_counters(out, counters);
+        out << "}";
+    }
+
+    out << "],\"soe_opcodes\":[";
+    for (std::size_t i = 0; i < soe_opcodes.size(); ++i) {
+        out << (i ? "," : "") << "{\"opcode\":\"" << hex(soe_opcodes[i].first, 4) << "\",";
+        write_counters(out, soe_opcodes[i].second);
+        out << "}";
+    }
+
+    out << "],\"swg_opcodes\":[";
+    for (std::size_t i = 0; i < swg_opcodes.size(); ++i) {
+        out << (i ? "," : "") << "{\"opcode\":\"" << hex(swg_opcodes[i].first, 8) << "\",";
+        write_counters(out, swg_opcodes[i].second);
+        out << "}";
+    }
+
+    out << "],\"untracked_sessions\":{";
+    write_counters(out, untracked_sessions);
+    out << "},\"untracked_opcodes\":{";
+    write_counters(out, untracked_opcodes);
+    out << "}}";
+    return out.str();
+}
+
+} // namespace swganh
@@ -0,0 +1,118 @@
+// File: src/network/traffic_stats.hpp
+#pragma once
+
+#include <boost/asio.hpp>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "../core/types.hpp"
+
+namespace swganh {
+
+using boost::asio::ip::udp;
+
+struct TrafficCounters {
+    u64 packets_in = 0;
+    u64 bytes_in = 0;
+    u64 packets_out = 0;
+    u64 bytes_out = 0;
+
+    TrafficCounters& operator+=(const TrafficCounters& other) {
+        packets_in += other.packets_in;
+        bytes_in += other.bytes_in;
+        packets_out += other.packets_out;
+        bytes_out += other.bytes_out;
+        return *this;
+    }
+};
+
+struct TrafficSnapshot {
+    TrafficCounters total;
+    std::vector<std::pair<udp::endpoint, TrafficCounters>> sessions;
+    std::vector<std::pair<u16, TrafficCounters>> soe_opcodes;
+    std::vector<std::pair<u32, TrafficCounters>> swg_opcodes;
+    TrafficCounters untracked_sessions;  // Session table was full
+    TrafficCounters untracked_opcodes;   // SWG opcode table was full
+
+    std::string to_json() const;
+};
+
+// Per-session, per-SOE-opcode and per-SWG-opcode byte and packet counters.
+//
+// Every thread that records gets its own shard, so the hot path is a handful
+// of relaxed load/store pairs on memory no other thread writes - no locks and
+// no contended atomics. snapshot() walks all shards and merges them; readers
+// may see a packet's bytes before its packet count, which is fine for stats.
+class TrafficStats {
+public:
+    static TrafficStats& instance() {
+        static TrafficStats inst;
+        return inst;
+    }
+
+    // Whole datagrams as they cross the socket; the SOE opcode is read from
+    // the first two bytes
+    void record_in(const udp::endpoint& peer, const u8* data, std::size_t size);
+    void record_out(const udp::endpoint& peer, const u8* data, std::size_t size);
+
+    // SWG messages, recorded by whoever unwraps or builds them
+    void record_swg_in(u32 opcode, std::size_t size);
+    void record_swg_out(u32 opcode, std::size_t size);
+
+    TrafficSnapshot snapshot() const;
+
+    // Drop per-session counters; each shard clears itself on its next write.
+    // The session table never evicts, so the owner calls this periodically.
+    void reset_sessions() { session_epoch_.fetch_add(1, std::memory_order_relaxed); }
+
+private:
+    static constexpr std::size_t SESSION_SLOTS = 4096;
+    static constexpr std::size_t SWG_OPCODE_SLOTS = 512;
+    static constexpr std::size_t MAX_PROBES = 16;
+
+    struct Counters {
+        std::atomic<u64> packets_in{0};
+        std::atomic<u64> bytes_in{0};
+        std::atomic<u64> packets_out{0};
+        std::atomic<u64> bytes_out{0};
+
+        void add_in(std::size_t bytes);
+        void add_out(std::size_t bytes);
+        TrafficCounters load() const;
+        void clear();
+    };
+
+    template<typename Key>
+    struct Slot {
+        std::atomic<Key> key{0};  // 0 = empty
+        Counters counters;
+    };
+
+    struct Shard {
+        Counters total;
+        std::array<Counters, 256> soe_opcodes;
+        std::array<Slot<u64>, SESSION_SLOTS> sessions;
+        std::array<Slot<u32>, SWG_OPCODE_SLOTS> swg_opcodes;
+        Counters untracked_sessions;
+        Counters untracked_opcodes;
+        std::atomic<u64> session_epoch{0};  // Written by the owning thread only
+    };
+
+    TrafficStats() = default;
+
+    Shard& local_shard();
+    Counters& session_counters(Shard& shard, const udp::endpoint& peer);
+    Counters& swg_counters(Shard& shard, u32 opcode);
+
+    static u64 session_key(const udp::endpoint& peer);
+    static udp::endpoint session_endpoint(u64 key);
+
+    mutable std::mutex shards_mutex_;  // Registration and snapshots only
+    std::vector<std::unique_ptr<Shard>> shards_;
+    std::atomic<u64> session_epoch_{0};
+};
+
+} // namespace swganh
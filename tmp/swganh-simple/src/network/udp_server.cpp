@@ -1,11 +1,33 @@
 // File: src/network/udp_server.cpp
 #include "udp_server.hpp"
+#include "reuseport_steering.hpp"
+#include "traffic_stats.hpp"
 #include "../core/logger.hpp"
 
+#ifdef __linux__
+#include <sys/socket.h>
+#include <sys/ioctl.h>
+#include <poll.h>
+#include <linux/sockios.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#endif
+
 namespace swganh {
 
-UdpServer::UdpServer(u16 port) 
-    : port_(port), running_(false), io_context_(), work_guard_(io_context_.get_executor()) {
+using reuse_port = boost::asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>;
+
+UdpServer::UdpServer(u16 port, u32 worker_count)
+    : port_(port), running_(false) {
+    if (worker_count == 0) worker_count = 1;
+
+    for (u32 i = 0; i < worker_count; ++i) {
+        workers_.push_back(std::make_unique<Worker>(i));
+    }
 }
 
 UdpServer::~UdpServer() {
@@ -24,106 +46,467 @@ void UdpServer::start() {
     }
 
     try {
-        // Create socket and bind to all interfaces
-        socket_ = std::make_unique<udp::socket>(io_context_, 
-            udp::endpoint(boost::asio::ip::address::from_string("0.0.0.0"), port_));
-        
+        udp::endpoint local_endpoint(boost::asio::ip::address::from_string("0.0.0.0"), port_);
+        bool shared_port = workers_.size() > 1;
+
+        // Bind in worker order - the reuseport group indexes sockets the same way
+        for (auto& worker : workers_) {
+            worker->socket = std::make_unique<udp::socket>(worker->io_context);
+            worker->socket->open(local_endpoint.protocol());
+            if (shared_port) {
+                worker->socket->set_option(reuse_port(true));
+            }
+            worker->socket->bind(local_endpoint);
+            // Sends must report would_block so the scheduler can hold back
+            worker->socket->non_blocking(true);
+        }
+
+        if (shared_port &&
+            !attach_reuseport_steering(workers_.front()->socket->native_handle(), worker_count())) {
+            LOG_WARNING("Falling back to kernel 4-tuple hashing across workers");
+        }
+
+        if (!xdp_interface_.empty()) {
+            open_xdp();
+        }
+
         running_ = true;
-        start_receive();
-        
-        // Start IO context in separate thread
-        io_thread_ = std::thread([this]() {
-            LOG_DEBUG("UDP server IO thread started");
-            io_context_.run();
-            LOG_DEBUG("UDP server IO thread stopped");
-        });
-        
-        LOG_INFO_F("UDP server started on port {}", port_);
-        
+
+        for (auto& worker : workers_) {
+            Worker* w = worker.get();
+
+            if (w->xdp) {
+                w->io_thread = std::thread([this, w]() {
+                    LOG_DEBUG_F("UDP server AF_XDP thread {} started", w->index);
+                    run_xdp(*w);
+                    LOG_DEBUG_F("UDP server AF_XDP thread {} stopped", w->index);
+                });
+                continue;
+            }
+
+            if (busy_poll_) {
+                // Spin on the socket; the IO context is only polled for sends
+                w->io_thread = std::thread([this, w]() {
+                    LOG_DEBUG_F("UDP server busy-poll thread {} started", w->index);
+                    run_busy_poll(*w);
+                    LOG_DEBUG_F("UDP server busy-poll thread {} stopped", w->index);
+                });
+                continue;
+            }
+
+            start_receive(*w);
+
+            // Each worker runs its own IO context on a dedicated thread
+            w->io_thread = std::thread([w]() {
+                LOG_DEBUG_F("UDP server IO thread {} started", w->index);
+                w->io_context.run();
+                LOG_DEBUG_F("UDP server IO thread {} stopped", w->index);
+            });
+        }
+
+        LOG_INFO_F("UDP server started on port {} ({} workers, {} receive)", port_, workers_.size(),
+                  xdp_program_.is_attached() ? "AF_XDP" : busy_poll_ ? "busy-poll" : "reactor");
+
     } catch (const std::exception& e) {
         LOG_ERROR_F("Failed to start UDP server: {}", e.what());
+        for (auto& worker : workers_) {
+            worker->socket.reset();
+        }
         throw;
     }
 }
 
 void UdpServer::stop() {
     if (!running_) return;
-    
+
     LOG_INFO("Stopping UDP server...");
     running_ = false;
-    
-    if (socket_) {
-        socket_->close();
-    }
-    
-    work_guard_.reset();
-    io_context_.stop();
-    
-    if (io_thread_.joinable()) {
-        io_thread_.join();
-    }
-    
+
+    for (auto& worker : workers_) {
+        worker->work_guard.reset();
+        worker->io_context.stop();
+    }
+
+    // Sockets are closed only once no worker thread can still touch them
+    for (auto& worker : workers_) {
+        if (worker->io_thread.joinable()) {
+            worker->io_thread.join();
+        }
+
+        if (worker->socket) {
+            worker->socket->close();
+        }
+
+        worker->xdp.reset();
+    }
+
+    xdp_program_.detach();
+
+    LatencySnapshot latency = receive_latency();
+    if (latency.count > 0) {
+        LOG_INFO_F("Receive latency: p50 {} ns, p99 {} ns, p999 {} ns ({} packets)",
+                  latency.p50_ns, latency.p99_ns, latency.p999_ns, latency.count);
+    }
+
     LOG_INFO("UDP server stopped");
 }
 
-void UdpServer::send_packet(const std::vector<u8>& data, const udp::endpoint& target) {
-    if (!socket_ || !running_) {
+void UdpServer::set_busy_poll(bool enabled, u32 budget_us, int first_cpu) {
+    if (running_) {
+        LOG_WARNING("Busy-poll mode must be chosen before the server starts");
+        return;
+    }
+
+#ifdef __linux__
+    busy_poll_ = enabled;
+    busy_poll_budget_us_ = budget_us;
+    busy_poll_first_cpu_ = first_cpu;
+#else
+    if (enabled) {
+        LOG_WARNING("Busy-poll receive is only available on Linux");
+    }
+#endif
+}
+
+LatencySnapshot UdpServer::receive_latency() const {
+    std::vector<u64> totals;
+    for (const auto& worker : workers_) {
+        worker->receive_latency.accumulate(totals);
+    }
+    return LatencyHistogram::summarize(totals);
+}
+
+void UdpServer::send_packet(const std::vector<u8>& data, const udp::endpoint& target,
+                            SendPriority priority, std::chrono::milliseconds max_age) {
+    if (!running_) {
         LOG_ERROR("Cannot send packet - server not running");
         return;
     }
-    
-    // Post send operation to IO context
-    io_context_.post([this, data, target]() {
-        try {
-            socket_->send_to(boost::asio::buffer(data), target);
-            LOG_DEBUG_F("Sent {} bytes to {}:{}", data.size(), 
-                       target.address().to_string(), target.port());
-        } catch (const std::exception& e) {
-            LOG_ERROR_F("Failed to send packet: {}", e.what());
-        }
+
+    send_from(worker_for(target), data, target, priority, max_age);
+}
+
+u64 UdpServer::xdp_fallbacks() const {
+    u64 total = 0;
+    for (const auto& worker : workers_) {
+        total += worker->xdp_fallbacks.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+void UdpServer::log_stats() const {
+    LOG_INFO_F("UDP sends: {} unreliable packets dropped past their deadline", stale_drops());
+    LatencySnapshot latency = receive_latency();
+    if (latency.count > 0) {
+        LOG_INFO_F("Receive latency: p50 {} ns, p99 {} ns, p999 {} ns, max {} ns ({} packets)",
+                   latency.p50_ns, latency.p99_ns, latency.p999_ns, latency.max_ns, latency.count);
+    }
+    if (xdp_program_.is_attached()) {
+        LOG_INFO_F("AF_XDP: {} peer routes ({} refused while full, {} expired), {} sends via the kernel socket",
+                   xdp_peers_.size(), xdp_peers_.refused(), xdp_peers_.expired(), xdp_fallbacks());
+    }
+}
+
+u64 UdpServer::stale_drops() const {
+    u64 total = 0;
+    for (const auto& worker : workers_) {
+        total += worker->scheduler.dropped_stale();
+    }
+    return total;
+}
+
+void UdpServer::send_from(Worker& worker, const std::vector<u8>& data, const udp::endpoint& target,
+                          SendPriority priority, std::chrono::milliseconds max_age) {
+    OutboundPacket packet{data, target, priority, OutboundPacket::Clock::time_point::max()};
+    if (priority == SendPriority::UNRELIABLE_POSITION) {
+        // Deadline counts from the moment the caller asked, not from dequeue
+        packet.deadline = OutboundPacket::Clock::now() +
+            (max_age.count() > 0 ? max_age : SendScheduler::DEFAULT_UNRELIABLE_DEADLINE);
+    }
+
+    // Queue on the owning worker's IO context
+    Worker* w = &worker;
+    w->io_context.post([this, w, packet = std::move(packet)]() mutable {
+        w->scheduler.push(std::move(packet));
+        flush_sends(*w);
     });
 }
 
-void UdpServer::start_receive() {
-    if (!socket_ || !running_) return;
-    
-    socket_->async_receive_from(
-        boost::asio::buffer(receive_buffer_),
-        sender_endpoint_,
-        [this](const boost::system::error_code& error, std::size_t bytes_transferred) {
-            handle_receive(error, bytes_transferred);
+void UdpServer::flush_sends(Worker& worker) {
+    if (worker.send_blocked || !worker.socket) return;
+
+    OutboundPacket packet;
+    while (worker.scheduler.pop(packet, OutboundPacket::Clock::now())) {
+        if (worker.xdp) {
+            XdpSendResult sent = worker.xdp->send(packet.data.data(), packet.data.size(), packet.target);
+            if (sent == XdpSendResult::SENT) {
+                TrafficStats::instance().record_out(packet.target, packet.data.data(), packet.data.size());
+                continue;
+            }
+            if (sent == XdpSendResult::RING_FULL) {
+                // Wait for completions rather than overtake queued frames via the kernel
+                worker.xdp->kick();
+                worker.scheduler.requeue(std::move(packet));
+                worker.xdp_backlog = true;
+                return;
+            }
+            worker.xdp_fallbacks.store(worker.xdp_fallbacks.load(std::memory_order_relaxed) + 1,
+                                       std::memory_order_relaxed);
+        }
+
+        boost::system::error_code error;
+        worker.socket->send_to(boost::asio::buffer(packet.data), packet.target, 0, error);
+
+        if (error == boost::asio::error::would_block) {
+            // Socket buffer full - wait for room and re-evaluate priorities then
+            if (worker.xdp) worker.xdp->kick();
+            worker.scheduler.requeue(std::move(packet));
+            worker.send_blocked = true;
+
+            Worker* w = &worker;
+            worker.socket->async_wait(udp::socket::wait_write,
+                [this, w](const boost::system::error_code& wait_error) {
+                    w->send_blocked = false;
+                    if (!wait_error && running_) {
+                        flush_sends(*w);
+                    }
+                });
+            return;
+        }
+
+        if (error) {
+            LOG_ERROR_F("Failed to send packet: {}", error.message());
+        } else {
+            TrafficStats::instance().record_out(packet.target, packet.data.data(), packet.data.size());
+            LOG_DEBUG_F("Sent {} bytes to {}:{}", packet.data.size(),
+                       packet.target.address().to_string(), packet.target.port());
+        }
+    }
+
+    if (worker.xdp) {
+        worker.xdp->kick();
+    }
+}
+
+UdpServer::Worker& UdpServer::worker_for(const udp::endpoint& endpoint) {
+    if (workers_.size() == 1 || !endpoint.address().is_v4()) {
+        return *workers_.front();
+    }
+
+    u32 index = steering_index(endpoint.address().to_v4().to_uint(), worker_count());
+    return *workers_[index];
+}
+
+void UdpServer::start_receive(Worker& worker) {
+    if (!worker.socket || !running_) return;
+
+    worker.socket->async_receive_from(
+        boost::asio::buffer(worker.receive_buffer),
+        worker.sender_endpoint,
+        [this, &worker](const boost::system::error_code& error, std::size_t bytes_transferred) {
+            handle_receive(worker, error, bytes_transferred);
         }
     );
 }
 
-void UdpServer::handle_receive(const boost::system::error_code& error, std::size_t bytes_transferred) {
+void UdpServer::handle_receive(Worker& worker, const boost::system::error_code& error, std::size_t bytes_transferred) {
     if (!error && bytes_transferred > 0) {
-        // Convert buffer to vector
-        std::vector<u8> packet_data(receive_buffer_.begin(), 
-                                   receive_buffer_.begin() + bytes_transferred);
-        
-        // Call packet handler with send capability
-        if (packet_handler_) {
-            // Create send function for the handler
-            auto send_func = [this](const std::vector<u8>& response_data, const udp::endpoint& target) {
-                send_packet(response_data, target);
-            };
-            
-            packet_handler_(packet_data, sender_endpoint_, send_func);
-        } else {
-            LOG_INFO_F("Received {} bytes from {}:{} (no handler)", 
-                      bytes_transferred,
-                      sender_endpoint_.address().to_string(),
-                      sender_endpoint_.port());
+#ifdef __linux__
+        if (track_latency_) {
+            // Kernel timestamp of the datagram just read
+            timespec received{};
+            if (ioctl(worker.socket->native_handle(), SIOCGSTAMPNS, &received) == 0) {
+                timespec now{};
+                clock_gettime(CLOCK_REALTIME, &now);
+                i64 elapsed = (now.tv_sec - received.tv_sec) * 1000000000LL + (now.tv_nsec - received.tv_nsec);
+                worker.receive_latency.record(elapsed > 0 ? static_cast<u64>(elapsed) : 0);
+            }
         }
+#endif
+        dispatch(worker, worker.receive_buffer.data(), bytes_transferred, worker.sender_endpoint);
     } else if (error) {
         LOG_ERROR_F("Receive error: {}", error.message());
     }
-    
+
     // Continue receiving if still running
     if (running_) {
-        start_receive();
+        start_receive(worker);
+    }
+}
+
+void UdpServer::dispatch(Worker& worker, const u8* data, std::size_t size, const udp::endpoint& sender) {
+    TrafficStats::instance().record_in(sender, data, size);
+
+    // Convert buffer to vector
+    std::vector<u8> packet_data(data, data + size);
+
+    // Call packet handler with send capability
+    if (packet_handler_) {
+        // Responses leave through the socket the request arrived on
+        SendFunction send_func = [this, &worker](const std::vector<u8>& response_data,
+                                                 const udp::endpoint& target, SendPriority priority) {
+            if (running_) {
+                send_from(worker, response_data, target, priority, std::chrono::milliseconds::zero());
+            }
+        };
+
+        packet_handler_(packet_data, sender, send_func);
+    } else {
+        LOG_INFO_F("Received {} bytes from {}:{} (no handler)",
+                  size,
+                  sender.address().to_string(),
+                  sender.port());
+    }
+}
+
+#ifdef __linux__
+
+void UdpServer::run_busy_poll(Worker& worker) {
+    constexpr int BATCH_SIZE = 32;
+
+    if (busy_poll_first_cpu_ >= 0) {
+        // More workers than CPUs past first_cpu: the rest run unpinned
+        int cpu = busy_poll_first_cpu_ + static_cast<int>(worker.index);
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        if (cpu >= CPU_SETSIZE || (online > 0 && cpu >= online)) {
+            LOG_WARNING_F("Busy-poll worker {} not pinned: CPU {} is out of range ({} online)", worker.index,
+                         cpu, online);
+        } else {
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            CPU_SET(cpu, &cpus);
+            if (pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) != 0) {
+                LOG_WARNING_F("Could not pin busy-poll worker {} to CPU {}", worker.index, cpu);
+            }
+        }
+    }
+
+    int fd = worker.socket->native_handle();
+    int budget = static_cast<int>(busy_poll_budget_us_);
+    if (setsockopt(fd, SOL_SOCKET, SO_BUSY_POLL, &budget, sizeof(budget)) != 0) {
+        LOG_WARNING_F("SO_BUSY_POLL unavailable ({}), spinning on recvmmsg only", std::strerror(errno));
+    }
+    int enable = 1;
+    setsockopt(fd, SOL_SOCKET, SO_TIMESTAMPNS, &enable, sizeof(enable));
+
+    using Buffer = std::array<u8, 1024>;
+    std::vector<Buffer> buffers(BATCH_SIZE);
+    std::array<mmsghdr, BATCH_SIZE> messages{};
+    std::array<iovec, BATCH_SIZE> iovecs{};
+    std::array<sockaddr_storage, BATCH_SIZE> addresses{};
+    std::array<std::array<char, CMSG_SPACE(sizeof(timespec))>, BATCH_SIZE> controls{};
+
+    for (int i = 0; i < BATCH_SIZE; ++i) {
+        iovecs[i].iov_base = buffers[i].data();
+        iovecs[i].iov_len = buffers[i].size();
+        messages[i].msg_hdr.msg_iov = &iovecs[i];
+        messages[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    while (running_) {
+        // recvmmsg writes these back, so reset them every round
+        for (int i = 0; i < BATCH_SIZE; ++i) {
+            messages[i].msg_hdr.msg_name = &addresses[i];
+            messages[i].msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+            messages[i].msg_hdr.msg_control = controls[i].data();
+            messages[i].msg_hdr.msg_controllen = controls[i].size();
+        }
+
+        int received = recvmmsg(fd, messages.data(), BATCH_SIZE, MSG_DONTWAIT, nullptr);
+
+        if (received > 0) {
+            for (int i = 0; i < received; ++i) {
+                msghdr& header = messages[i].msg_hdr;
+
+                udp::endpoint sender;
+                std::memcpy(sender.data(), header.msg_name, header.msg_namelen);
+                sender.resize(header.msg_namelen);
+
+                for (cmsghdr* cmsg = CMSG_FIRSTHDR(&header); cmsg; cmsg = CMSG_NXTHDR(&header, cmsg)) {
+                    if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+                        timespec stamp;
+                        std::memcpy(&stamp, CMSG_DATA(cmsg), sizeof(stamp));
+                        timespec now{};
+                        clock_gettime(CLOCK_REALTIME, &now);
+                        i64 elapsed = (now.tv_sec - stamp.tv_sec) * 1000000000LL + (now.tv_nsec - stamp.tv_nsec);
+                        worker.receive_latency.record(elapsed > 0 ? static_cast<u64>(elapsed) : 0);
+                    }
+                }
+
+                dispatch(worker, buffers[i].data(), messages[i].msg_len, sender);
+            }
+        } else if (received < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+            LOG_ERROR_F("Receive error: {}", std::strerror(errno));
+        }
+
+        // Run queued sends and write-readiness waits without blocking
+        worker.io_context.poll();
+    }
+}
+
+void UdpServer::run_xdp(Worker& worker) {
+    auto handler = [this, &worker](const u8* data, std::size_t size, const udp::endpoint& sender) {
+        dispatch(worker, data, size, sender);
+    };
+
+    pollfd waits[2] = {
+        {worker.xdp->native_handle(), POLLIN, 0},
+        {worker.socket->native_handle(), POLLIN, 0},
+    };
+
+    while (running_) {
+        std::size_t handled = worker.xdp->receive(handler);
+
+        // Fragments, IP options and other traffic the program passed up
+        boost::system::error_code error;
+        std::size_t bytes = worker.socket->receive_from(
+            boost::asio::buffer(worker.receive_buffer), worker.sender_endpoint, 0, error);
+        if (!error && bytes > 0) {
+            dispatch(worker, worker.receive_buffer.data(), bytes, worker.sender_endpoint);
+            ++handled;
+        }
+
+        worker.io_context.poll();
+        
+        if (worker.xdp_backlog) {
+            worker.xdp_backlog = false;
+            flush_sends(worker);
+        }
+
+        // Without busy-poll, sleep briefly when both paths are idle
+        if (handled == 0 && !busy_poll_) {
+            poll(waits, 2, 1);
+        }
+    }
+}
+
+#else
+
+void UdpServer::run_busy_poll(Worker& worker) {
+    worker.io_context.run();
+}
+
+void UdpServer::run_xdp(Worker& worker) {
+    worker.io_context.run();
+}
+
+#endif
+
+void UdpServer::open_xdp() {
+    if (!xdp_program_.attach(xdp_interface_, port_)) {
+        LOG_ERROR("AF_XDP backend unavailable, using the kernel UDP path");
+        return;
+    }
+
+    // One socket per worker, bound to the interface queue of the same index
+    for (auto& worker : workers_) {
+        auto xdp = std::make_unique<XdpSocket>(xdp_program_.interface_index(), worker->index, port_, xdp_peers_);
+        if (xdp->open() && xdp_program_.register_socket(worker->index, xdp->native_handle())) {
+            worker->xdp = std::move(xdp);
+        } else {
+            LOG_WARNING_F("AF_XDP: worker {} stays on the kernel UDP path", worker->index);
+        }
     }
 }
 
-} // namespace swganh
\ No newline at end of file
+} // namespace swganh
@@ -2,48 +2,133 @@
 #pragma once
 
 #include <boost/asio.hpp>
+#include <array>
+#include <atomic>
 #include <functional>
 #include <vector>
 #include <thread>
 #include <memory>
 #include "../core/types.hpp"
+#include "send_scheduler.hpp"
+#include "../core/latency_histogram.hpp"
+#include "xdp_socket.hpp"
 
 namespace swganh {
 
 using boost::asio::ip::udp;
 
+// Send callback handed to packet handlers
+using SendFunction = std::function<void(const std::vector<u8>&, const udp::endpoint&, SendPriority)>;
+
 // Packet handler type that can send responses
-using PacketHandler = std::function<void(const std::vector<u8>&, const udp::endpoint&, 
-                                       std::function<void(const std::vector<u8>&, const udp::endpoint&)>)>;
+using PacketHandler = std::function<void(const std::vector<u8>&, const udp::endpoint&, SendFunction)>;
 
+// Receives on one or more workers. With worker_count > 1 every worker owns
+// its own SO_REUSEPORT socket, io_context and thread, and a steering program
+// keeps each client on the same worker for the lifetime of its session.
 class UdpServer {
 public:
-    explicit UdpServer(u16 port);
+    explicit UdpServer(u16 port, u32 worker_count = 1);
     ~UdpServer();
     
     void set_packet_handler(PacketHandler handler);
     void start();
     void stop();
     
-    // Send packet to specific endpoint
-    void send_packet(const std::vector<u8>& data, const udp::endpoint& target);
+    // Send packet to specific endpoint. Unreliable packets not sent within
+    // max_age are dropped (zero selects the scheduler default).
+    void send_packet(const std::vector<u8>& data, const udp::endpoint& target,
+                     SendPriority priority = SendPriority::RELIABLE_DATA,
+                     std::chrono::milliseconds max_age = std::chrono::milliseconds::zero());
+    
+    // Unreliable packets dropped for missing their deadline, all workers;
+    // part of log_stats()
+    u64 stale_drops() const;
+    
+    // Opt-in low-latency receive, set before start(). Each worker spins on
+    // its socket with SO_BUSY_POLL and non-blocking recvmmsg instead of
+    // sleeping in the reactor, pinned to first_cpu + worker index when
+    // first_cpu >= 0. Burns one core per worker.
+    void set_busy_poll(bool enabled, u32 budget_us = 50, int first_cpu = -1);
+    
+    // Kernel-receive-to-handler latency. Always on in busy-poll mode; in
+    // reactor mode it costs one ioctl per packet, so it is opt-in.
+    void set_latency_tracking(bool enabled) { track_latency_ = enabled; }
+    LatencySnapshot receive_latency() const;
+    
+    // Experimental: receive and transmit through AF_XDP sockets on the named
+    // interface (generic mode), one per worker queue. Set before start().
+    // Datagrams the XDP program passes up still arrive on the kernel socket.
+    // Replies to peers with no learned route (never seen on the XDP path,
+    // or the route table was full) also leave through the kernel socket and
+    // may overtake earlier XDP frames; they are counted as fallbacks.
+    void set_xdp_backend(const std::string& interface) { xdp_interface_ = interface; }
+    
+    // Sends that fell back to the kernel socket in AF_XDP mode, all workers
+    u64 xdp_fallbacks() const;
+    
+    // Counters for a SIGUSR1 dump
+    void log_stats() const;
+    
+    // Executor of the worker that owns this client's session. Work finished
+    // on other threads posts here so the reply leaves in session order.
+    boost::asio::io_context::executor_type executor_for(const udp::endpoint& endpoint) {
+        return worker_for(endpoint).io_context.get_executor();
+    }
     
     bool is_running() const { return running_; }
+    u32 worker_count() const { return static_cast<u32>(workers_.size()); }
 
 private:
-    void start_receive();
-    void handle_receive(const boost::system::error_code& error, std::size_t bytes_transferred);
+    struct Worker {
+        explicit Worker(u32 worker_index) 
+            : index(worker_index), io_context(), work_guard(io_context.get_executor()) {}
+        
+        u32 index;
+        boost::asio::io_context io_context;
+        boost::asio::executor_work_guard<boost::asio::io_context::executor_type> work_guard;
+        std::unique_ptr<udp::socket> socket;
+        std::thread io_thread;
+        
+        std::array<u8, 1024> receive_buffer;
+        udp::endpoint sender_endpoint;
+        
+        SendScheduler scheduler;
+        bool send_blocked = false;
+        
+        LatencyHistogram receive_latency;
+        
+        std::unique_ptr<XdpSocket> xdp;
+        bool xdp_backlog = false;  // TX ring was full; flush again next loop
+        std::atomic<u64> xdp_fallbacks{0};  // Written by this worker only
+    };
+    
+    void start_receive(Worker& worker);
+    void handle_receive(Worker& worker, const boost::system::error_code& error, std::size_t bytes_transferred);
+    void run_busy_poll(Worker& worker);
+    void run_xdp(Worker& worker);
+    void open_xdp();
+    void dispatch(Worker& worker, const u8* data, std::size_t size, const udp::endpoint& sender);
+    void send_from(Worker& worker, const std::vector<u8>& data, const udp::endpoint& target,
+                   SendPriority priority, std::chrono::milliseconds max_age);
+    void flush_sends(Worker& worker);
+    
+    // Worker that owns the session for this client
+    Worker& worker_for(const udp::endpoint& endpoint);
     
     u16 port_;
-    bool running_;
+    std::atomic<bool> running_;
+    
+    bool busy_poll_ = false;
+    u32 busy_poll_budget_us_ = 50;
+    int busy_poll_first_cpu_ = -1;
+    bool track_latency_ = false;
     
-    boost::asio::io_context io_context_;
-    boost::asio::executor_work_guard<boost::asio::io_context::executor_type> work_guard_;
-    std::unique_ptr<udp::socket> socket_;
-    std::thread io_thread_;
+    std::string xdp_interface_;
+    XdpProgram xdp_program_;
+    XdpPeerTable xdp_peers_{65536, std::chrono::seconds(120)};
     
-    std::array<u8, 1024> receive_buffer_;
-    udp::endpoint sender_endpoint_;
+    std::vector<std::unique_ptr<Worker>> workers_;
     
     PacketHandler packet_handler_;
 };
@@ -0,0 +1,540 @@
+// File: src/network/xdp_socket.cpp
+#include "xdp_socket.hpp"
+#include "../core/logger.hpp"
+
+#include <algorithm>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <net/if.h>
+#include <linux/bpf.h>
+#include <linux/if_link.h>
+#include <linux/if_xdp.h>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#endif
+
+#ifndef AF_XDP
+#define AF_XDP 44
+#endif
+
+#ifndef SOL_XDP
+#define SOL_XDP 283
+#endif
+
+namespace swganh {
+
+XdpPeerTable::XdpPeerTable(std::size_t max_routes, std::chrono::seconds idle_timeout)
+    : max_per_shard_(std::max<std::size_t>(max_routes / SHARD_COUNT, 1)), idle_timeout_(idle_timeout) {
+}
+
+void XdpPeerTable::learn(u32 address, u16 port, const Route& route, Clock::time_point now) {
+    u64 peer = key(address, port);
+    Shard& shard = shard_for(peer);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto it = shard.routes.find(peer);
+    if (it == shard.routes.end()) {
+        if (shard.routes.size() >= max_per_shard_) {
+            // Sweeping is linear, so a flood of new sources sweeps once a second at most
+            if (now >= shard.next_sweep) {
+                shard.next_sweep = now + std::chrono::seconds(1);
+                std::size_t removed = std::erase_if(shard.routes, [&](const auto& entry) {
+                    return now - entry.second.last_seen > idle_timeout_;
+                });
+                expired_.fetch_add(removed, std::memory_order_relaxed);
+            }
+            if (shard.routes.size() >= max_per_shard_) {
+                refused_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+        }
+        it = shard.routes.emplace(peer, Entry{}).first;
+    }
+    it->second.route = route;
+    it->second.last_seen = now;
+}
+
+bool XdpPeerTable::find(u32 address, u16 port, Route& out) const {
+    u64 peer = key(address, port);
+    const Shard& shard = shard_for(peer);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.routes.find(peer);
+    if (it == shard.routes.end()) return false;
+    out = it->second.route;
+    return true;
+}
+
+std::size_t XdpPeerTable::size() const {
+    std::size_t total = 0;
+    for (const Shard& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        total += shard.routes.size();
+    }
+    return total;
+}
+
+#ifdef __linux__
+
+namespace {
+
+constexpr u32 FRAME_SIZE = 2048;
+constexpr u32 FRAME_COUNT = 4096;
+constexpr u32 RX_FRAMES = FRAME_COUNT / 2;
+constexpr u32 RING_SIZE = 2048;
+
+constexpr std::size_t ETH_HEADER = 14;
+constexpr std::size_t IPV4_HEADER = 20;
+constexpr std::size_t UDP_HEADER = 8;
+constexpr std::size_t FRAME_HEADERS = ETH_HEADER + IPV4_HEADER + UDP_HEADER;
+
+long bpf(int command, bpf_attr& attr) {
+    return syscall(__NR_bpf, command, &attr, sizeof(attr));
+}
+
+bpf_insn instruction(u8 code, u8 dst, u8 src, i16 offset, i32 imm) {
+    bpf_insn insn{};
+    insn.code = code;
+    insn.dst_reg = dst;
+    insn.src_reg = src;
+    insn.off = offset;
+    insn.imm = imm;
+    return insn;
+}
+
+// Redirect IPv4/UDP to port -> XSKMAP[rx_queue_index], otherwise XDP_PASS.
+// Packet fields are loaded little-endian, so network-order constants below
+// are byte-swapped.
+std::vector<bpf_insn> build_redirect_program(int map_fd, u16 port) {
+    constexpr u8 R0 = 0, R1 = 1, R2 = 2, R3 = 3, R4 = 4, R5 = 5, R6 = 6;
+    constexpr i16 PASS = 23;
+    auto to_pass = [](int pc) { return static_cast<i16>(PASS - pc - 1); };
+    i32 port_le = static_cast<i32>(((port & 0xFF) << 8) | (port >> 8));
+
+    return {
+        /*  0 */ instruction(BPF_ALU64 | BPF_MOV | BPF_X, R6, R1, 0, 0),
+        /*  1 */ instruction(BPF_LDX | BPF_MEM | BPF_W, R2, R6, offsetof(xdp_md, data), 0),
+        /*  2 */ instruction(BPF_LDX | BPF_MEM | BPF_W, R3, R6, offsetof(xdp_md, data_end), 0),
+        /*  3 */ instruction(BPF_ALU64 | BPF_MOV | BPF_X, R4, R2, 0, 0),
+        /*  4 */ instruction(BPF_ALU64 | BPF_ADD | BPF_K, R4, 0, 0, static_cast<i32>(FRAME_HEADERS)),
+        /*  5 */ instruction(BPF_JMP | BPF_JGT | BPF_X, R4, R3, to_pass(5), 0),
+        /*  6 */ instruction(BPF_LDX | BPF_MEM | BPF_H, R5, R2, 12, 0),            // ethertype
+        /*  7 */ instruction(BPF_JMP | BPF_JNE | BPF_K, R5, 0, to_pass(7), 0x0008),
+        /*  8 */ instruction(BPF_LDX | BPF_MEM | BPF_B, R5, R2, 14, 0),            // version/IHL
+        /*  9 */ instruction(BPF_JMP | BPF_JNE | BPF_K, R5, 0, to_pass(9), 0x45),
+        /* 10 */ instruction(BPF_LDX | BPF_MEM | BPF_H, R5, R2, 20, 0),            // flags/fragment
+        /* 11 */ instruction(BPF_ALU64 | BPF_AND | BPF_K, R5, 0, 0, 0xFF3F),
+        /* 12 */ instruction(BPF_JMP | BPF_JNE | BPF_K, R5, 0, to_pass(12), 0),
+        /* 13 */ instruction(BPF_LDX | BPF_MEM | BPF_B, R5, R2, 23, 0),            // protocol
+        /* 14 */ instruction(BPF_JMP | BPF_JNE | BPF_K, R5, 0, to_pass(14), 17),
+        /* 15 */ instruction(BPF_LDX | BPF_MEM | BPF_H, R5, R2, 36, 0),            // UDP destination
+        /* 16 */ instruction(BPF_JMP | BPF_JNE | BPF_K, R5, 0, to_pass(16), port_le),
+        /* 17 */ instruction(BPF_LDX | BPF_MEM | BPF_W, R2, R6, offsetof(xdp_md, rx_queue_index), 0),
+        /* 18 */ instruction(BPF_LD | BPF_DW | BPF_IMM, R1, BPF_PSEUDO_MAP_FD, 0, map_fd),
+        /* 19 */ instruction(0, 0, 0, 0, 0),
+        /* 20 */ instruction(BPF_ALU64 | BPF_MOV | BPF_K, R3, 0, 0, XDP_PASS),   // fallback if no socket
+        /* 21 */ instruction(BPF_JMP | BPF_CALL, 0, 0, 0, BPF_FUNC_redirect_map),
+        /* 22 */ instruction(BPF_JMP | BPF_EXIT, 0, 0, 0, 0),
+        /* 23 */ instruction(BPF_ALU64 | BPF_MOV | BPF_K, R0, 0, 0, XDP_PASS),
+        /* 24 */ instruction(BPF_JMP | BPF_EXIT, 0, 0, 0, 0),
+    };
+}
+
+u16 ipv4_checksum(const u8* header) {
+    u32 sum = 0;
+    for (std::size_t i = 0; i < IPV4_HEADER; i += 2) {
+        sum += (header[i] << 8) | header[i + 1];
+    }
+    while (sum >> 16) sum = (sum & 0xFFFF) + (sum >> 16);
+    return static_cast<u16>(~sum);
+}
+
+u32 load_acquire(u32* value) {
+    return std::atomic_ref<u32>(*value).load(std::memory_order_acquire);
+}
+
+void store_release(u32* value, u32 data) {
+    std::atomic_ref<u32>(*value).store(data, std::memory_order_release);
+}
+
+} // namespace
+
+XdpProgram::~XdpProgram() {
+    detach();
+}
+
+bool XdpProgram::attach(const std::string& interface, u16 port) {
+    interface_index_ = if_nametoindex(interface.c_str());
+    if (interface_index_ == 0) {
+        LOG_ERROR_F("AF_XDP: unknown interface '{}'", interface);
+        return false;
+    }
+
+    bpf_attr attr{};
+    attr.map_type = BPF_MAP_TYPE_XSKMAP;
+    attr.key_size = sizeof(u32);
+    attr.value_size = sizeof(u32);
+    attr.max_entries = 64;
+    map_fd_ = static_cast<int>(bpf(BPF_MAP_CREATE, attr));
+    if (map_fd_ < 0) {
+        LOG_ERROR_F("AF_XDP: could not create XSKMAP: {}", std::strerror(errno));
+        return false;
+    }
+
+    std::vector<bpf_insn> program = build_redirect_program(map_fd_, port);
+    std::vector<char> verifier_log(4096);
+    const char license[] = "Dual MIT/GPL";
+
+    attr = bpf_attr{};
+    attr.prog_type = BPF_PROG_TYPE_XDP;
+    attr.insns = reinterpret_cast<u64>(program.data());
+    attr.insn_cnt = static_cast<u32>(program.size());
+    attr.license = reinterpret_cast<u64>(license);
+    attr.log_buf = reinterpret_cast<u64>(verifier_log.data());
+    attr.log_size = static_cast<u32>(verifier_log.size());
+    attr.log_level = 1;
+    program_fd_ = static_cast<int>(bpf(BPF_PROG_LOAD, attr));
+    if (program_fd_ < 0) {
+        LOG_ERROR_F("AF_XDP: program rejected: {} {}", std::strerror(errno), verifier_log.data());
+        detach();
+        return false;
+    }
+
+    // Link-based attach detaches automatically if the process dies
+    attr = bpf_attr{};
+    attr.link_create.prog_fd = static_cast<u32>(program_fd_);
+    attr.link_create.target_ifindex = interface_index_;
+    attr.link_create.attach_type = BPF_XDP;
+    attr.link_create.flags = XDP_FLAGS_SKB_MODE;
+    link_fd_ = static_cast<int>(bpf(BPF_LINK_CREATE, attr));
+    if (link_fd_ < 0) {
+        LOG_ERROR_F("AF_XDP: could not attach to '{}': {}", interface, std::strerror(errno));
+        detach();
+        return false;
+    }
+
+    LOG_INFO_F("AF_XDP program attached to {} (generic mode) for UDP port {}", interface, port);
+    return true;
+}
+
+void XdpProgram::detach() {
+    for (int* fd : {&link_fd_, &program_fd_, &map_fd_}) {
+        if (*fd >= 0) {
+            ::close(*fd);
+            *fd = -1;
+        }
+    }
+}
+
+bool XdpProgram::register_socket(u32 queue_id, int socket_fd) {
+    bpf_attr attr{};
+    u32 key = queue_id;
+    u32 value = static_cast<u32>(socket_fd);
+    attr.map_fd = static_cast<u32>(map_fd_);
+    attr.key = reinterpret_cast<u64>(&key);
+    attr.value = reinterpret_cast<u64>(&value);
+    attr.flags = BPF_ANY;
+
+    if (bpf(BPF_MAP_UPDATE_ELEM, attr) != 0) {
+        LOG_ERROR_F("AF_XDP: could not register queue {}: {}", queue_id, std::strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+XdpSocket::XdpSocket(unsigned int interface_index, u32 queue_id, u16 port, XdpPeerTable& peers)
+    : interface_index_(interface_index), queue_id_(queue_id), port_(port), peers_(peers) {
+}
+
+XdpSocket::~XdpSocket() {
+    close();
+}
+
+bool XdpSocket::map_ring(Ring& ring, u64 offset, u32 size, std::size_t descriptor_size,
+                         u64 producer_offset, u64 consumer_offset, u64 descriptor_offset) {
+    ring.size = size;
+    ring.mapping_length = descriptor_offset + size * descriptor_size;
+    ring.mapping = mmap(nullptr, ring.mapping_length, PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_POPULATE, fd_, static_cast<off_t>(offset));
+    if (ring.mapping == MAP_FAILED) {
+        ring.mapping = nullptr;
+        return false;
+    }
+
+    u8* base = static_cast<u8*>(ring.mapping);
+    ring.producer = reinterpret_cast<u32*>(base + producer_offset);
+    ring.consumer = reinterpret_cast<u32*>(base + consumer_offset);
+    ring.descriptors = base + descriptor_offset;
+    return true;
+}
+
+void XdpSocket::unmap_ring(Ring& ring) {
+    if (ring.mapping) {
+        munmap(ring.mapping, ring.mapping_length);
+    }
+    ring = Ring{};
+}
+
+bool XdpSocket::open() {
+    fd_ = socket(AF_XDP, SOCK_RAW, 0);
+    if (fd_ < 0) {
+        LOG_ERROR_F("AF_XDP: socket() failed: {}", std::strerror(errno));
+        return false;
+    }
+
+    umem_length_ = static_cast<std::size_t>(FRAME_SIZE) * FRAME_COUNT;
+    void* area = mmap(nullptr, umem_length_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (area == MAP_FAILED) {
+        LOG_ERROR_F("AF_XDP: UMEM allocation failed: {}", std::strerror(errno));
+        close();
+        return false;
+    }
+    umem_ = static_cast<u8*>(area);
+
+    xdp_umem_reg registration{};
+    registration.addr = reinterpret_cast<u64>(umem_);
+    registration.len = umem_length_;
+    registration.chunk_size = FRAME_SIZE;
+    registration.headroom = 0;
+
+    u32 ring_size = RING_SIZE;
+    if (setsockopt(fd_, SOL_XDP, XDP_UMEM_REG, &registration, sizeof(registration)) != 0 ||
+        setsockopt(fd_, SOL_XDP, XDP_UMEM_FILL_RING, &ring_size, sizeof(ring_size)) != 0 ||
+        setsockopt(fd_, SOL_XDP, XDP_UMEM_COMPLETION_RING, &ring_size, sizeof(ring_size)) != 0 ||
+        setsockopt(fd_, SOL_XDP, XDP_RX_RING, &ring_size, sizeof(ring_size)) != 0 ||
+        setsockopt(fd_, SOL_XDP, XDP_TX_RING, &ring_size, sizeof(ring_size)) != 0) {
+        LOG_ERROR_F("AF_XDP: ring setup failed: {}", std::strerror(errno));
+        close();
+        return false;
+    }
+
+    xdp_mmap_offsets offsets{};
+    socklen_t offsets_length = sizeof(offsets);
+    if (getsockopt(fd_, SOL_XDP, XDP_MMAP_OFFSETS, &offsets, &offsets_length) != 0 ||
+        !map_ring(fill_, XDP_UMEM_PGOFF_FILL_RING, RING_SIZE, sizeof(u64),
+                  offsets.fr.producer, offsets.fr.consumer, offsets.fr.desc) ||
+        !map_ring(completion_, XDP_UMEM_PGOFF_COMPLETION_RING, RING_SIZE, sizeof(u64),
+                  offsets.cr.producer, offsets.cr.consumer, offsets.cr.desc) ||
+        !map_ring(rx_, XDP_PGOFF_RX_RING, RING_SIZE, sizeof(xdp_desc),
+                  offsets.rx.producer, offsets.rx.consumer, offsets.rx.desc) ||
+        !map_ring(tx_, XDP_PGOFF_TX_RING, RING_SIZE, sizeof(xdp_desc),
+                  offsets.tx.producer, offsets.tx.consumer, offsets.tx.desc)) {
+        LOG_ERROR_F("AF_XDP: ring mapping failed: {}", std::strerror(errno));
+        close();
+        return false;
+    }
+
+    // Hand the RX half of the UMEM to the kernel up front
+    u64* fill_slots = static_cast<u64*>(fill_.descriptors);
+    u32 produced = *fill_.producer;
+    for (u32 i = 0; i < RX_FRAMES; ++i) {
+        fill_slots[(produced + i) & (fill_.size - 1)] = static_cast<u64>(i) * FRAME_SIZE;
+    }
+    store_release(fill_.producer, produced + RX_FRAMES);
+
+    free_tx_frames_.clear();
+    for (u32 i = RX_FRAMES; i < FRAME_COUNT; ++i) {
+        free_tx_frames_.push_back(static_cast<u64>(i) * FRAME_SIZE);
+    }
+
+    sockaddr_xdp address{};
+    address.sxdp_family = AF_XDP;
+    address.sxdp_ifindex = interface_index_;
+    address.sxdp_queue_id = queue_id_;
+    address.sxdp_flags = XDP_COPY;
+    if (bind(fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        LOG_ERROR_F("AF_XDP: bind to queue {} failed: {}", queue_id_, std::strerror(errno));
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+void XdpSocket::close() {
+    unmap_ring(fill_);
+    unmap_ring(completion_);
+    unmap_ring(rx_);
+    unmap_ring(tx_);
+
+    if (umem_) {
+        munmap(umem_, umem_length_);
+        umem_ = nullptr;
+    }
+
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+
+    free_tx_frames_.clear();
+}
+
+std::size_t XdpSocket::receive(const ReceiveHandler& handler, std::size_t max_packets) {
+    if (fd_ < 0) return 0;
+
+    u32 consumed = *rx_.consumer;
+    u32 available = load_acquire(rx_.producer) - consumed;
+    u32 count = static_cast<u32>(std::min<std::size_t>(available, max_packets));
+    if (count == 0) return 0;
+
+    XdpPeerTable::Clock::time_point now = XdpPeerTable::Clock::now();
+    xdp_desc* descriptors = static_cast<xdp_desc*>(rx_.descriptors);
+    u64* fill_slots = static_cast<u64*>(fill_.descriptors);
+    u32 filled = *fill_.producer;
+
+    for (u32 i = 0; i < count; ++i) {
+        const xdp_desc& descriptor = descriptors[(consumed + i) & (rx_.size - 1)];
+        const u8* frame = umem_ + descriptor.addr;
+
+        // The program already checked ethertype, IHL, protocol and port
+        if (descriptor.len >= FRAME_HEADERS) {
+            std::size_t udp_length = (frame[38] << 8) | frame[39];
+            std::size_t payload_length = udp_length >= UDP_HEADER ? udp_length - UDP_HEADER : 0;
+            payload_length = std::min(payload_length, descriptor.len - FRAME_HEADERS);
+
+            u32 source = (frame[26] << 24) | (frame[27] << 16) | (frame[28] << 8) | frame[29];
+            u16 source_port = static_cast<u16>((frame[34] << 8) | frame[35]);
+
+            // Remember how to reach this peer for the reply
+            XdpPeerTable::Route route;
+            std::memcpy(route.peer_mac, frame + 6, 6);
+            std::memcpy(route.local_mac, frame, 6);
+            route.local_address = (frame[30] << 24) | (frame[31] << 16) | (frame[32] << 8) | frame[33];
+            peers_.learn(source, source_port, route, now);
+
+            udp::endpoint sender(boost::asio::ip::address_v4(source), source_port);
+            handler(frame + FRAME_HEADERS, payload_length, sender);
+            ++rx_packets_;
+        }
+
+        // Return the frame to the kernel (aligned mode: strip any offset)
+        fill_slots[(filled + i) & (fill_.size - 1)] = descriptor.addr & ~static_cast<u64>(FRAME_SIZE - 1);
+    }
+
+    store_release(rx_.consumer, consumed + count);
+    store_release(fill_.producer, filled + count);
+    return count;
+}
+
+void XdpSocket::recycle_completions() {
+    u32 consumed = *completion_.consumer;
+    u32 completed = load_acquire(completion_.producer) - consumed;
+    u64* slots = static_cast<u64*>(completion_.descriptors);
+
+    for (u32 i = 0; i < completed; ++i) {
+        free_tx_frames_.push_back(slots[(consumed + i) & (completion_.size - 1)]);
+    }
+    store_release(completion_.consumer, consumed + completed);
+}
+
+XdpSendResult XdpSocket::send(const u8* payload, std::size_t size, const udp::endpoint& target) {
+    if (fd_ < 0 || !target.address().is_v4() || size > FRAME_SIZE - FRAME_HEADERS) return XdpSendResult::NO_ROUTE;
+
+    u32 destination = target.address().to_v4().to_uint();
+    XdpPeerTable::Route route;
+    if (!peers_.find(destination, target.port(), route)) return XdpSendResult::NO_ROUTE;
+
+    recycle_completions();
+    u32 produced = *tx_.producer;
+    if (free_tx_frames_.empty() || produced - load_acquire(tx_.consumer) >= tx_.size) {
+        return XdpSendResult::RING_FULL;
+    }
+
+    u64 address = free_tx_frames_.back();
+    free_tx_frames_.pop_back();
+    u8* frame = umem_ + address;
+
+    // Ethernet
+    std::memcpy(frame, route.peer_mac, 6);
+    std::memcpy(frame + 6, route.local_mac, 6);
+    frame[12] = 0x08;
+    frame[13] = 0x00;
+
+    // IPv4, no options, don't fragment
+    u8* ip = frame + ETH_HEADER;
+    u16 total_length = static_cast<u16>(IPV4_HEADER + UDP_HEADER + size);
+    u16 id = next_ip_id_++;
+    u32 source = route.local_address;
+    u8 ip_header[IPV4_HEADER] = {
+        0x45, 0x00, static_cast<u8>(total_length >> 8), static_cast<u8>(total_length),
+        static_cast<u8>(id >> 8), static_cast<u8>(id), 0x40, 0x00,
+        64, 17, 0x00, 0x00,
+        static_cast<u8>(source >> 24), static_cast<u8>(source >> 16),
+        static_cast<u8>(source >> 8), static_cast<u8>(source),
+        static_cast<u8>(destination >> 24), static_cast<u8>(destination >> 16),
+        static_cast<u8>(destination >> 8), static_cast<u8>(destination),
+    };
+    u16 checksum = ipv4_checksum(ip_header);
+    ip_header[10] = static_cast<u8>(checksum >> 8);
+    ip_header[11] = static_cast<u8>(checksum);
+    std::memcpy(ip, ip_header, IPV4_HEADER);
+
+    // UDP - a zero checksum means "none" over IPv4
+    u8* udp_header = ip + IPV4_HEADER;
+    u16 udp_length = static_cast<u16>(UDP_HEADER + size);
+    udp_header[0] = static_cast<u8>(port_ >> 8);
+    udp_header[1] = static_cast<u8>(port_);
+    udp_header[2] = static_cast<u8>(target.port() >> 8);
+    udp_header[3] = static_cast<u8>(target.port());
+    udp_header[4] = static_cast<u8>(udp_length >> 8);
+    udp_header[5] = static_cast<u8>(udp_length);
+    udp_header[6] = 0;
+    udp_header[7] = 0;
+
+    std::memcpy(udp_header + UDP_HEADER, payload, size);
+
+    xdp_desc& descriptor = static_cast<xdp_desc*>(tx_.descriptors)[produced & (tx_.size - 1)];
+    descriptor.addr = address;
+    descriptor.len = static_cast<u32>(FRAME_HEADERS + size);
+    descriptor.options = 0;
+    store_release(tx_.producer, produced + 1);
+
+    ++pending_tx_;
+    ++tx_packets_;
+    return XdpSendResult::SENT;
+}
+
+void XdpSocket::kick() {
+    if (fd_ < 0 || pending_tx_ == 0) return;
+
+    // Copy mode always needs a syscall to start transmission
+    if (sendto(fd_, nullptr, 0, MSG_DONTWAIT, nullptr, 0) < 0 &&
+        errno != EAGAIN && errno != EBUSY && errno != ENOBUFS) {
+        LOG_WARNING_F("AF_XDP: transmit kick failed: {}", std::strerror(errno));
+    }
+    pending_tx_ = 0;
+}
+
+#else
+
+XdpProgram::~XdpProgram() = default;
+
+bool XdpProgram::attach(const std::string&, u16) {
+    LOG_ERROR("AF_XDP is only available on Linux");
+    return false;
+}
+
+void XdpProgram::detach() {}
+
+bool XdpProgram::register_socket(u32, int) { return false; }
+
+XdpSocket::XdpSocket(unsigned int interface_index, u32 queue_id, u16 port, XdpPeerTable& peers)
+    : interface_index_(interface_index), queue_id_(queue_id), port_(port), peers_(peers) {
+}
+
+XdpSocket::~XdpSocket() = default;
+
+bool XdpSocket::open() { return false; }
+void XdpSocket::close() {}
+std::size_t XdpSocket::receive(const ReceiveHandler&, std::size_t) { return 0; }
+XdpSendResult XdpSocket::send(const u8*, std::size_t, const udp::endpoint&) { return XdpSendResult::NO_ROUTE; }
+void XdpSocket::kick() {}
+
+#endif
+
+} // namespace swganh
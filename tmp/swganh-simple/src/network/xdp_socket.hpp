@@ -0,0 +1,180 @@
+// File: src/network/xdp_socket.hpp
+#pragma once
+
+#include <boost/asio.hpp>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../core/types.hpp"
+
+namespace swganh {
+
+using boost::asio::ip::udp;
+
+// Experimental AF_XDP receive/transmit path, generic (SKB) mode only so it
+// works on loopback, veth pairs and any NIC without driver support.
+//
+// XdpProgram owns the eBPF side: an XSKMAP and a small XDP program that
+// redirects IPv4/UDP datagrams for one port to the socket registered for the
+// receiving queue. Everything else - other ports, IP options, fragments,
+// queues without a socket - is passed to the kernel stack untouched.
+class XdpProgram {
+public:
+    XdpProgram() = default;
+    ~XdpProgram();
+
+    XdpProgram(const XdpProgram&) = delete;
+    XdpProgram& operator=(const XdpProgram&) = delete;
+
+    bool attach(const std::string& interface, u16 port);
+    void detach();
+
+    // Route packets arriving on queue_id to the given AF_XDP socket
+    bool register_socket(u32 queue_id, int socket_fd);
+
+    bool is_attached() const { return link_fd_ >= 0; }
+    unsigned int interface_index() const { return interface_index_; }
+
+private:
+    int map_fd_ = -1;
+    int program_fd_ = -1;
+    int link_fd_ = -1;
+    unsigned int interface_index_ = 0;
+};
+
+// How to address replies to each peer, learned from its frames: MAC
+// addresses and the local IPv4 address it wrote to. Shared by every worker's
+// socket, because RSS picks the queue a peer's frames arrive on while the
+// reply leaves from the worker that owns the session, which may differ.
+//
+// Spoofed sources could otherwise grow it without limit, so it holds at most
+// max_routes peers. A full shard drops routes idle for longer than
+// idle_timeout (at most once a second) and otherwise learns nothing new;
+// replies to an unknown peer go out through the kernel socket.
+class XdpPeerTable {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Route {
+        u8 peer_mac[6];
+        u8 local_mac[6];
+        u32 local_address;
+    };
+
+    XdpPeerTable(std::size_t max_routes, std::chrono::seconds idle_timeout);
+
+    void learn(u32 address, u16 port, const Route& route, Clock::time_point now = Clock::now());
+    bool find(u32 address, u16 port, Route& out) const;
+
+    std::size_t size() const;
+    u64 refused() const { return refused_.load(std::memory_order_relaxed); }  // Not learned, table full
+    u64 expired() const { return expired_.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr std::size_t SHARD_COUNT = 16;
+
+    struct Entry {
+        Route route;
+        Clock::time_point last_seen;
+    };
+
+    struct alignas(64) Shard {
+        mutable std::mutex mutex;
+        std::unordered_map<u64, Entry> routes;
+        Clock::time_point next_sweep{};
+    };
+
+    static u64 key(u32 address, u16 port) { return (static_cast<u64>(address) << 16) | port; }
+    Shard& shard_for(u64 key) { return shards_[(key ^ (key >> 16)) % SHARD_COUNT]; }
+    const Shard& shard_for(u64 key) const { return shards_[(key ^ (key >> 16)) % SHARD_COUNT]; }
+
+    std::size_t max_per_shard_;
+    std::chrono::seconds idle_timeout_;
+    std::array<Shard, SHARD_COUNT> shards_;
+    std::atomic<u64> refused_{0};
+    std::atomic<u64> expired_{0};
+};
+
+// Why XdpSocket::send did not queue a datagram
+enum class XdpSendResult {
+    SENT,
+    NO_ROUTE,   // Peer not in the table; send through the kernel socket
+    RING_FULL   // Try again after kick(); the kernel path would reorder
+};
+
+// One AF_XDP socket bound to a single interface queue. Frames are copied
+// into a private UMEM; the lower half of it feeds the RX fill ring and the
+// upper half is the TX frame pool. Not thread-safe - owned by one worker.
+class XdpSocket {
+public:
+    // Payload, payload length, sender
+    using ReceiveHandler = std::function<void(const u8*, std::size_t, const udp::endpoint&)>;
+
+    XdpSocket(unsigned int interface_index, u32 queue_id, u16 port, XdpPeerTable& peers);
+    ~XdpSocket();
+
+    XdpSocket(const XdpSocket&) = delete;
+    XdpSocket& operator=(const XdpSocket&) = delete;
+
+    bool open();
+    void close();
+
+    int native_handle() const { return fd_; }
+
+    // Drain up to max_packets from the RX ring. Returns packets handled.
+    std::size_t receive(const ReceiveHandler& handler, std::size_t max_packets = 64);
+
+    // Queue a datagram for transmission. Only peers some socket has
+    // received from can be addressed, since their MAC addresses come from
+    // those frames.
+    XdpSendResult send(const u8* payload, std::size_t size, const udp::endpoint& target);
+
+    // Ask the kernel to transmit everything queued since the last kick
+    void kick();
+
+    u64 received_packets() const { return rx_packets_; }
+    u64 sent_packets() const { return tx_packets_; }
+
+private:
+    struct Ring {
+        u32* producer = nullptr;
+        u32* consumer = nullptr;
+        void* descriptors = nullptr;
+        u32 size = 0;
+        void* mapping = nullptr;
+        std::size_t mapping_length = 0;
+    };
+
+    bool map_ring(Ring& ring, u64 offset, u32 size, std::size_t descriptor_size,
+                  u64 producer_offset, u64 consumer_offset, u64 descriptor_offset);
+    void unmap_ring(Ring& ring);
+    void recycle_completions();
+
+    unsigned int interface_index_;
+    u32 queue_id_;
+    u16 port_;
+
+    int fd_ = -1;
+    u8* umem_ = nullptr;
+    std::size_t umem_length_ = 0;
+
+    Ring fill_;
+    Ring completion_;
+    Ring rx_;
+    Ring tx_;
+
+    std::vector<u64> free_tx_frames_;
+    XdpPeerTable& peers_;
+    u16 next_ip_id_ = 0;
+    u32 pending_tx_ = 0;
+
+    u64 rx_packets_ = 0;
+    u64 tx_packets_ = 0;
+};
+
+} // namespace swganh
@@ -0,0 +1,68 @@
+// File: src/servers/login/character_list_cache.cpp
+#include "character_list_cache.hpp"
+#include "swg_protocol.hpp"
+#include "../../core/character_manager.hpp"
+#include "../../core/config.hpp"
+#include "../../core/logger.hpp"
+
+namespace swganh {
+namespace login {
+
+CharacterListCache::CharacterListCache()
+    : max_entries_(static_cast<size_t>(Config::instance().get_int("character_list_cache_size", 10000))) {
+    CharacterManager::instance().add_change_listener([this](u32 account_id) { invalidate(account_id); });
+}
+
+std::shared_ptr<const std::vector<u8>> CharacterListCache::get(u32 account_id) {
+    u64 invalidations_before;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(account_id);
+        if (it != entries_.end()) {
+            hits_.fetch_add(1, std::memory_order_relaxed);
+            return it->second;
+        }
+        invalidations_before = invalidations_;
+    }
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    
+    // Build outside the lock; other accounts keep being served meanwhile
+    auto message = std::make_shared<const std::vector<u8>>(
+        SWGLoginProtocol::create_enumerate_character_id(CharacterManager::instance().get_characters(account_id)));
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    // A create or delete during the build may not be in our copy; serve it
+    // once but do not keep it
+    if (invalidations_ == invalidations_before) {
+        if (entries_.size() >= max_entries_) {
+            entries_.erase(entries_.begin());
+        }
+        entries_.emplace(account_id, message);
+    }
+    return message;
+}
+
+void CharacterListCache::invalidate(u32 account_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.erase(account_id);
+    ++invalidations_;
+}
+
+CharacterListCacheStats CharacterListCache::stats() const {
+    CharacterListCacheStats stats;
+    stats.hits = hits_.load(std::memory_order_relaxed);
+    stats.misses = misses_.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats.invalidations = invalidations_;
+    stats.entries = entries_.size();
+    return stats;
+}
+
+void CharacterListCache::log_stats() const {
+    CharacterListCacheStats s = stats();
+    LOG_INFO_F("Character list cache: {} entries, {} hits, {} misses, {} invalidations",
+               s.entries, s.hits, s.misses, s.invalidations);
+}
+
+} // namespace login
+} // namespace swganh
@@ -0,0 +1,52 @@
+// File: src/servers/login/character_list_cache.hpp
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "../../core/types.hpp"
+
+namespace swganh {
+namespace login {
+
+struct CharacterListCacheStats {
+    u64 hits = 0;
+    u64 misses = 0;
+    u64 invalidations = 0;
+    size_t entries = 0;
+};
+
+// Serialized EnumerateCharacterId per account. A login is answered from the
+// cached bytes; the entry is dropped when CharacterManager reports a create
+// or delete for that account, so reconnects never re-query or re-encode.
+class CharacterListCache {
+public:
+    static CharacterListCache& instance() {
+        static CharacterListCache inst;
+        return inst;
+    }
+    
+    // EnumerateCharacterId (unwrapped) for the account
+    std::shared_ptr<const std::vector<u8>> get(u32 account_id);
+    
+    void invalidate(u32 account_id);
+    
+    CharacterListCacheStats stats() const;
+    void log_stats() const;
+
+private:
+    CharacterListCache();
+    
+    std::unordered_map<u32, std::shared_ptr<const std::vector<u8>>> entries_;
+    u64 invalidations_ = 0;  // Guarded by mutex_; lets a build notice it raced a change
+    size_t max_entries_;
+    mutable std::mutex mutex_;
+    
+    std::atomic<u64> hits_{0};
+    std::atomic<u64> misses_{0};
+};
+
+} // namespace login
+} // namespace swganh
@@ -0,0 +1,162 @@
+// File: src/servers/login/login_admission.cpp
+#include "login_admission.hpp"
+#include "../../core/logger.hpp"
+
+namespace swganh {
+namespace login {
+
+LoginAdmission::Decision LoginAdmission::request(const udp::endpoint& client, Start start, Notify notify,
+                                                 Refuse refuse) {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    // Resends while waiting or authenticating
+    if (in_flight_.count(client)) return Decision::STARTED;
+    for (const Waiting& waiting : queue_) {
+        if (waiting.client == client) return Decision::QUEUED;
+    }
+
+    // A logged-in client logging in again replaces its own session
+    size_t connections = in_flight_.size() + queue_.size() + sessions_.size() - sessions_.count(client);
+    if (connections >= limits_.max_connections) {
+        ++rejected_full_;
+        return Decision::FULL;
+    }
+
+    if (in_flight_.size() < limits_.max_concurrent && queue_.empty()) {
+        sessions_.erase(client);
+        in_flight_.insert(client);
+        ++started_;
+        lock.unlock();
+
+        if (!start()) {
+            // The caller answers this client; any waiters that got in
+            // meanwhile are promoted into the freed slot
+            std::vector<Waiting> starts;
+            {
+                std::lock_guard<std::mutex> relock(mutex_);
+                in_flight_.erase(client);
+                ++rejected_full_;
+                starts = promote_locked();
+            }
+            run_starts(std::move(starts));
+            return Decision::FULL;
+        }
+        return Decision::STARTED;
+    }
+
+    if (queue_.size() >= limits_.max_queued) {
+        ++rejected_full_;
+        return Decision::FULL;
+    }
+
+    sessions_.erase(client);
+    u32 position = static_cast<u32>(queue_.size() + 1);
+    queue_.push_back(Waiting{client, std::move(start), notify, std::move(refuse), position});
+    if (queue_.size() > max_queued_) max_queued_ = queue_.size();
+    lock.unlock();
+
+    notify(position);
+    return Decision::QUEUED;
+}
+
+void LoginAdmission::finished(const udp::endpoint& client, bool logged_in) {
+    std::vector<Waiting> starts;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        in_flight_.erase(client);
+        if (logged_in) sessions_[client] = Clock::now();
+        starts = promote_locked();
+    }
+    run_starts(std::move(starts));
+}
+
+void LoginAdmission::disconnected(const udp::endpoint& client) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    sessions_.erase(client);
+
+    for (auto it = queue_.begin(); it != queue_.end(); ++it) {
+        if (it->client == client) {
+            queue_.erase(it);
+            break;
+        }
+    }
+}
+
+void LoginAdmission::tick(Clock::time_point now) {
+    std::vector<std::pair<Notify, u32>> updates;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        for (auto it = sessions_.begin(); it != sessions_.end();) {
+            it = (now - it->second >= limits_.session_timeout) ? sessions_.erase(it) : std::next(it);
+        }
+
+        for (size_t i = 0; i < queue_.size(); ++i) {
+            u32 position = static_cast<u32>(i + 1);
+            if (queue_[i].notified_position != position) {
+                queue_[i].notified_position = position;
+                updates.emplace_back(queue_[i].notify, position);
+            }
+        }
+    }
+
+    for (auto& [notify, position] : updates) {
+        notify(position);
+    }
+}
+
+std::vector<LoginAdmission::Waiting> LoginAdmission::promote_locked() {
+    std::vector<Waiting> starts;
+    while (in_flight_.size() < limits_.max_concurrent && !queue_.empty()) {
+        starts.push_back(std::move(queue_.front()));
+        queue_.pop_front();
+        in_flight_.insert(starts.back().client);
+        ++started_;
+    }
+    return starts;
+}
+
+void LoginAdmission::run_starts(std::vector<Waiting> starts) {
+    std::vector<Waiting> refused;
+    while (!starts.empty()) {
+        size_t first_failed = refused.size();
+        for (Waiting& waiting : starts) {
+            if (!waiting.start()) refused.push_back(std::move(waiting));
+        }
+        if (refused.size() == first_failed) break;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (size_t i = first_failed; i < refused.size(); ++i) {
+            in_flight_.erase(refused[i].client);
+            ++rejected_full_;
+        }
+        starts = promote_locked();
+    }
+
+    for (Waiting& waiting : refused) {
+        LOG_WARNING_F("Could not start queued login for {}:{}", waiting.client.address().to_string(),
+                      waiting.client.port());
+        waiting.refuse();
+    }
+}
+
+AdmissionStats LoginAdmission::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    AdmissionStats result;
+    result.in_flight = in_flight_.size();
+    result.queued = queue_.size();
+    result.sessions = sessions_.size();
+    result.max_queued = max_queued_;
+    result.started = started_;
+    result.rejected_full = rejected_full_;
+    return result;
+}
+
+void LoginAdmission::log_stats() const {
+    AdmissionStats s = stats();
+    LOG_INFO_F("Login admission: {} in flight, {} queued (max {}), {} sessions, {} started, {} rejected as full",
+               s.in_flight, s.queued, s.max_queued, s.sessions, s.started, s.rejected_full);
+}
+
+} // namespace login
+} // namespace swganh
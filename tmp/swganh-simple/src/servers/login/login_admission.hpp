@@ -0,0 +1,101 @@
+// File: src/servers/login/login_admission.hpp
+#pragma once
+
+#include <boost/asio.hpp>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include <vector>
+#include "../../core/types.hpp"
+
+namespace swganh {
+namespace login {
+
+using boost::asio::ip::udp;
+
+struct AdmissionLimits {
+    u32 max_concurrent = 32;    // Logins being authenticated at once
+    u32 max_queued = 500;       // Logins waiting for a slot
+    u32 max_connections = 1000; // In flight + queued + logged-in sessions
+    std::chrono::seconds session_timeout{300};
+};
+
+struct AdmissionStats {
+    u64 in_flight = 0;
+    u64 queued = 0;
+    u64 sessions = 0;
+    u64 max_queued = 0;
+    u64 started = 0;
+    u64 rejected_full = 0;
+};
+
+// Controlled admission for login storms. Up to max_concurrent logins are
+// authenticated at once; the rest wait in a FIFO and are told their
+// position as it changes. Past the queue limit, or once max_connections
+// clients are already in the system, the answer is SERVER_FULL.
+class LoginAdmission {
+public:
+    enum class Decision {
+        STARTED,  // Authentication is under way (or already was)
+        QUEUED,   // Waiting; notify() has been given the position
+        FULL      // Caller should answer SERVER_FULL
+    };
+
+    // Begin authentication; false if it could not be handed off
+    using Start = std::function<bool()>;
+    // Tell a waiting client its 1-based queue position
+    using Notify = std::function<void(u32 position)>;
+    // Answer SERVER_FULL to a queued client whose start() failed
+    using Refuse = std::function<void()>;
+
+    using Clock = std::chrono::steady_clock;
+
+    explicit LoginAdmission(const AdmissionLimits& limits) : limits_(limits) {}
+
+    // A client resending its login while waiting or in flight keeps its place.
+    // refuse is only used if the client was queued and later could not start.
+    Decision request(const udp::endpoint& client, Start start, Notify notify, Refuse refuse);
+
+    // Authentication finished; frees the slot and starts the next waiter.
+    // A successful login counts as a session until disconnect or timeout.
+    void finished(const udp::endpoint& client, bool logged_in);
+
+    void disconnected(const udp::endpoint& client);
+
+    // Expire idle sessions and send queue-position updates; call periodically
+    void tick(Clock::time_point now = Clock::now());
+
+    AdmissionStats stats() const;
+    void log_stats() const;
+
+private:
+    struct Waiting {
+        udp::endpoint client;
+        Start start;
+        Notify notify;
+        Refuse refuse;
+        u32 notified_position;
+    };
+
+    // Pops waiters into free slots; caller runs the returned starts unlocked
+    std::vector<Waiting> promote_locked();
+    // Runs starts until none fail, freeing failed slots and promoting the
+    // next waiters into them, then refuses the clients that failed
+    void run_starts(std::vector<Waiting> starts);
+
+    AdmissionLimits limits_;
+
+    mutable std::mutex mutex_;
+    std::set<udp::endpoint> in_flight_;
+    std::deque<Waiting> queue_;
+    std::map<udp::endpoint, Clock::time_point> sessions_;
+    u64 max_queued_ = 0;
+    u64 started_ = 0;
+    u64 rejected_full_ = 0;
+};
+
+} // namespace login
+} // namespace swganh
@@ -0,0 +1,41 @@
+// File: src/servers/login/login_messages.hpp
+#pragma once
+
+#include "../../network/message_schema.hpp"
+#include "../../network/swg_opcode.hpp"
+
+namespace swganh {
+namespace login {
+
+// Wire layouts of the login-server messages. Each alias is the single source
+// for encoding, decoding and sizing that message.
+namespace messages {
+
+using namespace swganh::schema;
+
+// Client -> server: username, password, client version
+using LoginClientId = Message<4, opcode("LoginClientId"), AString, AString, AString>;
+
+// Server -> client: session key, station id, username
+using LoginClientToken = Message<4, opcode("LoginClientToken"), Blob, U32, AString>;
+
+// Server -> client: galaxies {id, name, distance}, max characters per account
+using LoginEnumCluster = Message<3, opcode("LoginEnumCluster"), List<U32, AString, U32>, U32>;
+
+// Server -> client: galaxy status {id, address, port, ping port, population,
+// max capacity, max characters, distance, status, not recommended}
+using LoginClusterStatus = Message<2, opcode("LoginClusterStatus"),
+    List<U32, AString, U16, U16, I32, U32, U32, U32, U32, U8>>;
+
+// Server -> client: the account's characters {name, species template CRC,
+// object id, galaxy id, status}
+using EnumerateCharacterId = Message<2, opcode("EnumerateCharacterId"),
+    List<UString, U32, U64, U32, U32>>;
+
+// Server -> client: error type, message, fatal flag
+using ErrorMessage = Message<3, opcode("ErrorMessage"), AString, AString, U8>;
+
+} // namespace messages
+
+} // namespace login
+} // namespace swganh
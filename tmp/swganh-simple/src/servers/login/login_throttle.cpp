@@ -0,0 +1,173 @@
+// File: src/servers/login/login_throttle.cpp
+#include "login_throttle.hpp"
+#include "../../core/logger.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+namespace swganh {
+namespace login {
+
+std::string LoginThrottle::username_key(std::string_view username) {
+    std::string key;
+    key.reserve(username.size() + 1);
+    key += 'u';
+    key += username;
+    return key;
+}
+
+std::string LoginThrottle::address_key(const boost::asio::ip::address& address) {
+    std::string key(1, 'a');
+    if (address.is_v4()) {
+        auto bytes = address.to_v4().to_bytes();
+        key.append(bytes.begin(), bytes.end());
+    } else if (address.to_v6().is_v4_mapped()) {
+        auto bytes = boost::asio::ip::make_address_v4(boost::asio::ip::v4_mapped, address.to_v6()).to_bytes();
+        key.append(bytes.begin(), bytes.end());
+    } else {
+        // The /64 prefix; the interface id is the host's to choose
+        auto bytes = address.to_v6().to_bytes();
+        key.append(bytes.begin(), bytes.begin() + 8);
+    }
+    return key;
+}
+
+LoginThrottle::Counter* LoginThrottle::find(Shard& shard, const std::string& key, bool create) {
+    auto it = shard.index.find(key);
+    if (it != shard.index.end()) {
+        shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+        return &it->second->counter;
+    }
+    if (!create) return nullptr;
+
+    size_t per_shard = std::max<size_t>(limits_.max_entries / SHARD_COUNT, 1);
+    if (shard.entries.size() >= per_shard) {
+        erase(shard, std::prev(shard.entries.end()));
+        evicted_.fetch_add(1, std::memory_order_relaxed);
+    }
+    shard.entries.push_front(Entry{key, Counter{}});
+    shard.index.emplace(shard.entries.front().key, shard.entries.begin());
+    entries_.fetch_add(1, std::memory_order_relaxed);
+    return &shard.entries.front().counter;
+}
+
+void LoginThrottle::erase(Shard& shard, std::list<Entry>::iterator it) {
+    shard.index.erase(it->key);
+    shard.entries.erase(it);
+    entries_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+double LoginThrottle::estimate(Counter& counter, Clock::time_point now) const {
+    auto since = now.time_since_epoch();
+    u64 window = static_cast<u64>(since / limits_.window);
+    if (window != counter.window) {
+        counter.previous = window == counter.window + 1 ? counter.current : 0;
+        counter.current = 0;
+        counter.window = window;
+    }
+
+    // Share of the previous window still inside the sliding one
+    double elapsed = std::chrono::duration<double>(since - window * limits_.window) / limits_.window;
+    return counter.current + counter.previous * (1.0 - elapsed);
+}
+
+bool LoginThrottle::take(const std::string& key, u32 limit, Clock::time_point now) {
+    Shard& shard = shard_for(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    Counter* counter = find(shard, key, true);
+    // Checked and counted under one lock, so concurrent attempts cannot overshoot
+    if (estimate(*counter, now) >= limit) return false;
+    counter->current++;
+    return true;
+}
+
+void LoginThrottle::give_back(const std::string& key, Clock::time_point now) {
+    Shard& shard = shard_for(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    Counter* counter = find(shard, key, false);
+    if (!counter) return;
+    estimate(*counter, now);
+    // The attempt may have been counted in the window that just ended
+    if (counter->current > 0) {
+        counter->current--;
+    } else if (counter->previous > 0) {
+        counter->previous--;
+    }
+}
+
+bool LoginThrottle::at_limit(const std::string& key, u32 limit, Clock::time_point now) {
+    Shard& shard = shard_for(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    Counter* counter = find(shard, key, false);
+    return counter && estimate(*counter, now) >= limit;
+}
+
+bool LoginThrottle::allow(std::string_view username, const boost::asio::ip::address& address,
+                          Clock::time_point now) {
+    std::string user = username_key(username);
+    if (take(user, limits_.max_per_username, now)) {
+        if (take(address_key(address), limits_.max_per_address, now)) {
+            allowed_.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        give_back(user, now);
+    }
+    throttled_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+bool LoginThrottle::record_failure(std::string_view username, const boost::asio::ip::address& address,
+                                   Clock::time_point now) {
+    failures_.fetch_add(1, std::memory_order_relaxed);
+    return at_limit(username_key(username), limits_.max_per_username, now) ||
+           at_limit(address_key(address), limits_.max_per_address, now);
+}
+
+void LoginThrottle::record_success(std::string_view username, const boost::asio::ip::address& address,
+                                   Clock::time_point now) {
+    std::string key = username_key(username);
+    {
+        Shard& shard = shard_for(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.index.find(key);
+        if (it != shard.index.end()) erase(shard, it->second);
+    }
+    give_back(address_key(address), now);
+}
+
+void LoginThrottle::release(std::string_view username, const boost::asio::ip::address& address,
+                            Clock::time_point now) {
+    give_back(username_key(username), now);
+    give_back(address_key(address), now);
+}
+
+void LoginThrottle::compact(Clock::time_point now) {
+    u64 window = static_cast<u64>(now.time_since_epoch() / limits_.window);
+    for (Shard& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for (auto it = shard.entries.begin(); it != shard.entries.end();) {
+            auto next = std::next(it);
+            if (it->counter.window + 1 < window) erase(shard, it);
+            it = next;
+        }
+    }
+}
+
+ThrottleStats LoginThrottle::stats() const {
+    ThrottleStats stats;
+    stats.allowed = allowed_.load(std::memory_order_relaxed);
+    stats.throttled = throttled_.load(std::memory_order_relaxed);
+    stats.failures = failures_.load(std::memory_order_relaxed);
+    stats.evicted = evicted_.load(std::memory_order_relaxed);
+    stats.entries = entries_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void LoginThrottle::log_stats() const {
+    ThrottleStats s = stats();
+    LOG_INFO_F("Login throttle: {} allowed, {} throttled, {} failures, {} keys ({} evicted)",
+               s.allowed, s.throttled, s.failures, s.entries, s.evicted);
+}
+
+} // namespace login
+} // namespace swganh
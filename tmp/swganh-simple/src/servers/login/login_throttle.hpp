@@ -0,0 +1,136 @@
+// File: src/servers/login/login_throttle.hpp
+#pragma once
+
+#include <boost/asio.hpp>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <list>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include "../../core/types.hpp"
+
+namespace swganh {
+namespace login {
+
+struct ThrottleLimits {
+    u32 max_per_username = 5;   // Failed logins per account name per window
+    u32 max_per_address = 20;   // Per IPv4 address or IPv6 /64; several players may share one
+    std::chrono::seconds window{300};
+    size_t max_entries = 200000; // Keys tracked at once, across both kinds
+};
+
+struct ThrottleStats {
+    u64 allowed = 0;
+    u64 throttled = 0;
+    u64 failures = 0;
+    u64 evicted = 0;    // Least recently used keys dropped because the table was full
+    size_t entries = 0;
+};
+
+// Brute-force limits, checked on the IO thread before a login is handed to
+// the auth pool, so a throttled attempt costs a hash lookup instead of a
+// bcrypt verification.
+//
+// An attempt is counted when it is allowed, not when bcrypt has rejected
+// it: a burst of logins sent before the first verification finishes gets
+// exactly the limit through. Attempts that turn out not to be failures are
+// given back with record_success() or release().
+//
+// Each username and each source address gets a sliding-window counter made
+// of two fixed windows: the estimate is the current window's count plus the
+// previous window's count scaled by how much of it still overlaps. That is
+// 16 bytes per key whatever the attempt rate. Keys idle for two windows
+// carry no information and are removed by compact().
+//
+// IPv6 addresses are keyed by their /64, the smallest block a host is
+// usually given, so one machine cannot spray keys from its own subnet.
+// When the table is full the least recently used key makes room: every
+// attempt is counted, and an attacker flooding new keys only pushes out
+// keys that have been quiet longer than the victim's.
+class LoginThrottle {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit LoginThrottle(const ThrottleLimits& limits) : limits_(limits) {}
+
+    // Counts an attempt against the username and the address. False, and
+    // nothing counted, if either has used up its attempts.
+    bool allow(std::string_view username, const boost::asio::ip::address& address,
+               Clock::time_point now = Clock::now());
+
+    // The allowed attempt was a wrong password (or unknown name); it stays
+    // counted. Returns true if the username or the address is now at its limit.
+    bool record_failure(std::string_view username, const boost::asio::ip::address& address,
+                        Clock::time_point now = Clock::now());
+
+    // The right password clears the username's count and gives the
+    // address its attempt back
+    void record_success(std::string_view username, const boost::asio::ip::address& address,
+                        Clock::time_point now = Clock::now());
+
+    // The allowed attempt was never decided (server full, store down,
+    // account disabled): gives both their attempt back
+    void release(std::string_view username, const boost::asio::ip::address& address,
+                 Clock::time_point now = Clock::now());
+
+    // Drops idle keys; call periodically
+    void compact(Clock::time_point now = Clock::now());
+
+    ThrottleStats stats() const;
+    void log_stats() const;
+
+private:
+    struct Counter {
+        u64 window = 0;  // Index of the current window since the clock's epoch
+        u32 current = 0;
+        u32 previous = 0;
+    };
+
+    static constexpr size_t SHARD_COUNT = 16;
+
+    struct Entry {
+        std::string key;
+        Counter counter;
+    };
+
+    // Most recently used first; the index keys view the entries' own strings
+    struct alignas(64) Shard {
+        mutable std::mutex mutex;
+        std::list<Entry> entries;
+        std::unordered_map<std::string_view, std::list<Entry>::iterator> index;
+    };
+
+    // Usernames and addresses share the table under distinct prefixes
+    static std::string username_key(std::string_view username);
+    static std::string address_key(const boost::asio::ip::address& address);
+
+    Shard& shard_for(const std::string& key) { return shards_[std::hash<std::string>{}(key) % SHARD_COUNT]; }
+
+    // Callers hold shard.mutex. Null if absent and create is false; marks
+    // the key as most recently used.
+    Counter* find(Shard& shard, const std::string& key, bool create);
+    void erase(Shard& shard, std::list<Entry>::iterator it);
+
+    // Moves the counter to now's window, then returns the sliding estimate
+    double estimate(Counter& counter, Clock::time_point now) const;
+
+    // Counts an attempt unless the key is at its limit; false if it is
+    bool take(const std::string& key, u32 limit, Clock::time_point now);
+    void give_back(const std::string& key, Clock::time_point now);
+    bool at_limit(const std::string& key, u32 limit, Clock::time_point now);
+
+    ThrottleLimits limits_;
+    std::array<Shard, SHARD_COUNT> shards_;
+
+    std::atomic<size_t> entries_{0};
+    std::atomic<u64> allowed_{0};
+    std::atomic<u64> throttled_{0};
+    std::atomic<u64> failures_{0};
+    std::atomic<u64> evicted_{0};
+};
+
+} // namespace login
+} // namespace swganh
@@ -0,0 +1,182 @@
+// File: src/servers/login/login_throttle_test.cpp
+#include "login_throttle.hpp"
+
+#include <gtest/gtest.h>
+#include <string>
+
+namespace swganh {
+namespace login {
+namespace {
+
+using boost::asio::ip::make_address;
+
+class LoginThrottleTest : public ::testing::Test {
+protected:
+    // Synthetic clock, starting on a window boundary
+    LoginThrottle::Clock::time_point at(std::chrono::seconds offset) const {
+        return LoginThrottle::Clock::time_point{} + limits_.window * 1000 + offset;
+    }
+
+    ThrottleLimits limits_;
+    LoginThrottle::Clock::time_point start_ = at(std::chrono::seconds(0));
+};
+
+TEST_F(LoginThrottleTest, BurstGetsExactlyTheUsernameLimit) {
+    LoginThrottle throttle(limits_);
+    int allowed = 0;
+    for (int i = 0; i < 500; ++i) {
+        auto address = make_address("10.0." + std::to_string(i / 250) + "." + std::to_string(i % 250));
+        if (throttle.allow("alice", address, start_)) ++allowed;
+    }
+    EXPECT_EQ(allowed, 5);
+    EXPECT_EQ(throttle.stats().throttled, 495u);
+}
+
+TEST_F(LoginThrottleTest, AddressLimitSpansUsernames) {
+    LoginThrottle throttle(limits_);
+    auto address = make_address("192.0.2.7");
+    int allowed = 0;
+    for (int i = 0; i < 100; ++i) {
+        if (throttle.allow("user" + std::to_string(i), address, start_)) ++allowed;
+    }
+    EXPECT_EQ(allowed, 20);
+}
+
+TEST_F(LoginThrottleTest, AddressRefusalCostsTheUsernameNothing) {
+    LoginThrottle throttle(limits_);
+    auto busy = make_address("192.0.2.7");
+    for (int i = 0; i < 20; ++i) ASSERT_TRUE(throttle.allow("user" + std::to_string(i), busy, start_));
+
+    for (int i = 0; i < 10; ++i) EXPECT_FALSE(throttle.allow("bob", busy, start_));
+
+    auto other = make_address("198.51.100.1");
+    int allowed = 0;
+    for (int i = 0; i < 10; ++i) {
+        if (throttle.allow("bob", other, start_)) ++allowed;
+    }
+    EXPECT_EQ(allowed, 5);
+}
+
+TEST_F(LoginThrottleTest, FailuresReportTheLimit) {
+    LoginThrottle throttle(limits_);
+    auto address = make_address("192.0.2.7");
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(throttle.allow("alice", address, start_));
+        EXPECT_FALSE(throttle.record_failure("alice", address, start_));
+    }
+    ASSERT_TRUE(throttle.allow("alice", address, start_));
+    EXPECT_TRUE(throttle.record_failure("alice", address, start_));
+    EXPECT_FALSE(throttle.allow("alice", address, start_));
+    EXPECT_EQ(throttle.stats().failures, 5u);
+}
+
+TEST_F(LoginThrottleTest, SuccessClearsTheUsernameAndReturnsTheAddressAttempt) {
+    LoginThrottle throttle(limits_);
+    auto address = make_address("192.0.2.7");
+    for (int i = 0; i < 4; ++i) ASSERT_TRUE(throttle.allow("alice", address, start_));
+    ASSERT_TRUE(throttle.allow("alice", address, start_));
+    throttle.record_success("alice", address, start_);
+
+    for (int i = 0; i < 5; ++i) EXPECT_TRUE(throttle.allow("alice", address, start_));
+    EXPECT_FALSE(throttle.allow("alice", address, start_));
+
+    // 4 failures + 5 since; the successful attempt was given back
+    int allowed = 0;
+    for (int i = 0; i < 20; ++i) {
+        if (throttle.allow("other" + std::to_string(i), address, start_)) ++allowed;
+    }
+    EXPECT_EQ(allowed, 11);
+}
+
+TEST_F(LoginThrottleTest, ReleasedAttemptsAreNotCounted) {
+    LoginThrottle throttle(limits_);
+    auto address = make_address("192.0.2.7");
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(throttle.allow("alice", address, start_));
+        throttle.release("alice", address, start_);
+    }
+}
+
+TEST_F(LoginThrottleTest, PreviousWindowFadesOut) {
+    LoginThrottle throttle(limits_);
+    auto address = make_address("192.0.2.7");
+    for (int i = 0; i < 5; ++i) ASSERT_TRUE(throttle.allow("alice", address, start_));
+    EXPECT_FALSE(throttle.allow("alice", address, at(limits_.window - std::chrono::seconds(1))));
+
+    // Halfway into the next window half of the old attempts still count
+    auto halfway = at(limits_.window + limits_.window / 2);
+    int allowed = 0;
+    for (int i = 0; i < 5; ++i) {
+        if (throttle.allow("alice", address, halfway)) ++allowed;
+    }
+    EXPECT_EQ(allowed, 3);
+
+    // Two windows of silence forget everything
+    allowed = 0;
+    for (int i = 0; i < 10; ++i) {
+        if (throttle.allow("alice", address, at(limits_.window * 4))) ++allowed;
+    }
+    EXPECT_EQ(allowed, 5);
+}
+
+TEST_F(LoginThrottleTest, Ipv6AddressesShareTheirSlash64) {
+    LoginThrottle throttle(limits_);
+    int allowed = 0;
+    for (int i = 0; i < 100; ++i) {
+        auto address = make_address("2001:db8:0:1::" + std::to_string(i + 1));
+        if (throttle.allow("user" + std::to_string(i), address, start_)) ++allowed;
+    }
+    EXPECT_EQ(allowed, 20);
+
+    EXPECT_TRUE(throttle.allow("someone", make_address("2001:db8:0:2::1"), start_));
+}
+
+TEST_F(LoginThrottleTest, V4MappedAddressesCountAsIpv4) {
+    LoginThrottle throttle(limits_);
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_TRUE(throttle.allow("a" + std::to_string(i), make_address("192.0.2.7"), start_));
+        ASSERT_TRUE(throttle.allow("b" + std::to_string(i), make_address("::ffff:192.0.2.7"), start_));
+    }
+    EXPECT_FALSE(throttle.allow("c", make_address("192.0.2.7"), start_));
+}
+
+TEST_F(LoginThrottleTest, FloodOfNewKeysDoesNotUnthrottleAnActiveVictim) {
+    limits_.max_entries = 160;
+    LoginThrottle throttle(limits_);
+    auto victim_address = make_address("192.0.2.7");
+    for (int i = 0; i < 5; ++i) ASSERT_TRUE(throttle.allow("victim", victim_address, start_));
+
+    // The attacker keeps guessing while spraying fresh names and addresses
+    for (int i = 0; i < 10000; ++i) {
+        auto address = make_address("10." + std::to_string(i / 65536 % 256) + "." +
+                                    std::to_string(i / 256 % 256) + "." + std::to_string(i % 256));
+        throttle.allow("spray" + std::to_string(i), address, start_);
+        if (i % 4 == 0) {
+            EXPECT_FALSE(throttle.allow("victim", victim_address, start_)) << i;
+        }
+    }
+
+    ThrottleStats stats = throttle.stats();
+    EXPECT_LE(stats.entries, limits_.max_entries);
+    EXPECT_GT(stats.evicted, 0u);
+}
+
+TEST_F(LoginThrottleTest, CompactDropsKeysIdleForTwoWindows) {
+    LoginThrottle throttle(limits_);
+    ASSERT_TRUE(throttle.allow("alice", make_address("192.0.2.7"), start_));
+    ASSERT_TRUE(throttle.allow("bob", make_address("192.0.2.8"), at(limits_.window)));
+    EXPECT_EQ(throttle.stats().entries, 4u);
+
+    throttle.compact(at(limits_.window));
+    EXPECT_EQ(throttle.stats().entries, 4u);
+
+    throttle.compact(at(limits_.window * 2));
+    EXPECT_EQ(throttle.stats().entries, 2u);
+
+    throttle.compact(at(limits_.window * 3));
+    EXPECT_EQ(throttle.stats().entries, 0u);
+}
+
+} // namespace
+} // namespace login
+} // namespace swganh
@@ -5,22 +5,57 @@
 #include <thread>
 #include <chrono>
 #include <csignal>
+#include <cstdlib>
+#include <span>
 
 #include "../../core/logger.hpp"
 #include "../../core/config.hpp"
 #include "../../core/account_manager.hpp"
+#include "../../core/character_manager.hpp"
+#ifdef SWGANH_WITH_POSTGRES
+#include "../../core/postgres_account_store.hpp"
+#endif
+#include "../../core/worker_pool.hpp"
+#include "../../core/galaxy_status_feed.hpp"
+#include "../../core/session_token.hpp"
+#include "../../network/message_schema.hpp"
 #include "../../network/udp_server.hpp"
+#include "../../network/traffic_stats.hpp"
 #include "swg_protocol.hpp"
+#include "server_list_cache.hpp"
+#include "character_list_cache.hpp"
+#include "login_admission.hpp"
+#include "login_throttle.hpp"
 
 using namespace swganh;
 
 volatile bool running = true;
+volatile bool dump_traffic = false;
+
+// Authentication runs here, off the IO workers
+WorkerPool* auth_pool = nullptr;
+
+// Decides which logins reach the auth pool now, later or not at all
+login::LoginAdmission* admission = nullptr;
+
+// Refuses logins for names and addresses with too many recent failures
+login::LoginThrottle* throttle = nullptr;
 
 void signal_handler(int) {
     LOG_INFO("Received shutdown signal");
     running = false;
 }
 
+void traffic_signal_handler(int) {
+    dump_traffic = true;
+}
+
+// SWG opcode of a message starting with its u16 operand count
+u32 swg_opcode_of(const u8* message, size_t size) {
+    if (size < 6) return 0;
+    return message[2] | (message[3] << 8) | (message[4] << 16) | (static_cast<u32>(message[5]) << 24);
+}
+
 // Create SOE Session Response packet
 std::vector<u8> create_session_response(uint32_t connection_id) {
     std::vector<u8> response;
@@ -110,35 +145,209 @@ void debug_login_packet(const std::vector<u8>& data) {
         LOG_INFO(swg_header.str());
     }
     
-    // Now let's manually parse the strings starting at offset 10
-    size_t offset = 10;
+    // Walk the strings after the SWG header with the same bounds-checked
+    // reader the parser uses, reporting how far a malformed packet gets
+    if (data.size() < 10) return;
+    const u8* in = data.data() + 10;
+    const u8* end = data.data() + data.size();
     
-    for (int i = 0; i < 3 && offset + 2 < data.size(); ++i) {
-        u16 len = data[offset] | (data[offset + 1] << 8);
-        
-        std::ostringstream str_info;
-        str_info << "String " << i << ": length = " << len << " at offset " << offset;
-        LOG_INFO(str_info.str());
-        
-        if (len > 0 && len < 1000 && offset + 2 + len <= data.size()) {
-            std::string str(data.begin() + offset + 2, data.begin() + offset + 2 + len);
-            std::ostringstream str_content;
-            str_content << "String " << i << ": '" << str << "'";
-            LOG_INFO(str_content.str());
-            offset += 2 + len;
-        } else {
-            std::ostringstream str_error;
-            str_error << "String " << i << " invalid or extends beyond packet";
-            LOG_WARNING(str_error.str());
+    for (int i = 0; i < 3 && in < end; ++i) {
+        size_t offset = static_cast<size_t>(in - data.data());
+        std::string_view str;
+        if (!schema::AString::read(in, end, str)) {
+            LOG_WARNING_F("String {} at offset {} extends beyond packet", i, offset);
+            break;
+        }
+        LOG_INFO_F("String {}: length = {} at offset {}", i, str.size(), offset);
+        if (str.size() > login::SWGLoginProtocol::MAX_LOGIN_STRING) {
+            LOG_WARNING_F("String {} longer than {} bytes", i, login::SWGLoginProtocol::MAX_LOGIN_STRING);
             break;
         }
+        LOG_INFO_F("String {}: '{}'", i, str);
     }
 }
 
+// Wrap an SWG message in an SOE data packet, account for it and send it
+void send_swg_message(const std::vector<u8>& message, u16 sequence,
+                      const boost::asio::ip::udp::endpoint& target,
+                      const SendFunction& send_response) {
+    TrafficStats::instance().record_swg_out(swg_opcode_of(message.data(), message.size()), message.size());
+    send_response(login::SWGLoginProtocol::wrap_in_soe_data(message, sequence), target,
+                  SendPriority::RELIABLE_DATA);
+}
+
+// Where a packet came from and how to answer it
+struct PacketContext {
+    const std::vector<u8>& data;
+    const boost::asio::ip::udp::endpoint& sender;
+    const SendFunction& send_response;
+    boost::asio::io_context::executor_type executor;  // IO worker that owns the session
+};
+
+// Runs on the session's IO worker once authentication has finished
+void send_login_result(LoginResult result, u32 account_id, const std::string& username,
+                       std::span<const u8> session_token,
+                       const boost::asio::ip::udp::endpoint& sender,
+                       const SendFunction& send_response) {
+    LOG_INFO("=== Authentication Result ===");
+    switch (result) {
+        case LoginResult::SUCCESS:
+            LOG_INFO("Login successful!");
+            break;
+        case LoginResult::INVALID_CREDENTIALS:
+            LOG_INFO("Login failed - invalid credentials");
+            break;
+        case LoginResult::ACCOUNT_DISABLED:
+            LOG_INFO("Login failed - account disabled");
+            break;
+        default:
+            LOG_INFO("Login failed - unknown error");
+            break;
+    }
+    
+    // Create and send login response
+    LOG_INFO("=== Sending Login Response ===");
+    std::vector<u8> login_response = 
+        login::SWGLoginProtocol::create_login_response(result, account_id, username, session_token);
+    send_swg_message(login_response, 1, sender, send_response);
+    LOG_INFO("Login response sent to client!");
+    
+    // If successful, follow up with the (shared, pre-serialized) server list
+    if (result == LoginResult::SUCCESS) {
+        auto server_list = login::ServerListCache::instance().get();
+        send_swg_message(server_list->enum_cluster, 2, sender, send_response);
+        send_swg_message(server_list->cluster_status, 3, sender, send_response);
+        LOG_INFO("Server list sent to client");
+        
+        auto character_list = login::CharacterListCache::instance().get(account_id);
+        send_swg_message(*character_list, 4, sender, send_response);
+        LOG_INFO("Character list sent to client");
+    }
+}
+
+// LoginClientId: authenticate on the auth pool, answer from the IO worker
+void handle_login_client_id(const PacketContext& packet) {
+    // Parse login request in place - fields borrow from data
+    login::LoginRequestView login_req;
+    if (!login::SWGLoginProtocol::parse_login_request_view(packet.data.data(), packet.data.size(), login_req)) {
+        LOG_WARNING("Malformed login request - ignoring");
+        return;
+    }
+    
+    LOG_INFO("=== Login Request Details ===");
+    LOG_INFO_F("  Username: '{}'", login_req.username);
+    LOG_INFO_F("  Password: '{}'", login_req.password);
+    LOG_INFO_F("  Client Version: '{}'", login_req.client_version);
+    
+    // Only proceed if we got a valid username
+    if (login_req.username.empty()) {
+        LOG_WARNING("Skipping authentication - username is empty (parsing failed)");
+        return;
+    }
+    
+    // Brute force stops here, before the auth pool and bcrypt. The attempt
+    // counts from now on, so a burst cannot outrun the verifications.
+    if (!throttle->allow(login_req.username, packet.sender.address())) {
+        LOG_WARNING_F("Login for '{}' throttled - too many failed attempts", login_req.username);
+        send_login_result(LoginResult::INVALID_CREDENTIALS, 0, std::string(login_req.username), {},
+                          packet.sender, packet.send_response);
+        return;
+    }
+    
+    // The receive buffer is reused as soon as we return, so the job owns its strings
+    auto request = std::make_shared<login::LoginRequest>(login_req.to_owned());
+    boost::asio::ip::udp::endpoint sender = packet.sender;
+    SendFunction send_response = packet.send_response;
+    auto executor = packet.executor;
+    
+    auto start = [request, sender, send_response, executor]() {
+        return auth_pool->try_submit([request, sender, send_response, executor]() {
+            AccountManager& account_mgr = AccountManager::instance();
+            // Anything escaping here would skip finished() and strand the slot
+            LoginResult result;
+            try {
+                result = account_mgr.authenticate(request->username, request->password);
+            } catch (const std::exception& e) {
+                LOG_ERROR_F("Login for '{}' failed: {}", request->username, e.what());
+                result = LoginResult::MAINTENANCE;
+            }
+            if (result == LoginResult::INVALID_CREDENTIALS) {
+                if (throttle->record_failure(request->username, sender.address())) {
+                    LOG_WARNING_F("Throttling logins for '{}' from {}", request->username,
+                                  sender.address().to_string());
+                }
+            } else if (result == LoginResult::SUCCESS) {
+                throttle->record_success(request->username, sender.address());
+            } else {
+                throttle->release(request->username, sender.address());
+            }
+            
+            // Get account ID if successful and sign the token zone servers will check
+            u32 account_id = 0;
+            SessionTokens::Token token{};
+            if (result == LoginResult::SUCCESS) {
+                auto account = account_mgr.get_account(request->username);
+                try {
+                    if (account) {
+                        account_id = account->account_id;
+                        token = SessionTokens::instance().issue(account_id, account->permissions.load(std::memory_order_relaxed));
+                    }
+                } catch (const std::exception& e) {
+                    LOG_ERROR_F("Could not issue session token: {}", e.what());
+                    result = LoginResult::MAINTENANCE;
+                }
+            }
+            
+            admission->finished(sender, result == LoginResult::SUCCESS);
+            
+            boost::asio::post(executor, [result, account_id, token, request, sender, send_response]() {
+                try {
+                    send_login_result(result, account_id, request->username, token, sender, send_response);
+                } catch (const std::exception& e) {
+                    LOG_ERROR_F("Error sending login response: {}", e.what());
+                }
+            });
+        });
+    };
+    
+    auto notify = [sender, send_response](u32 position) {
+        send_swg_message(login::SWGLoginProtocol::create_queue_position(position), 1, sender, send_response);
+    };
+    
+    // Queued, then the auth pool had no room when its turn came
+    auto refuse = [request, sender, send_response, executor]() {
+        throttle->release(request->username, sender.address());
+        boost::asio::post(executor, [request, sender, send_response]() {
+            send_login_result(LoginResult::SERVER_FULL, 0, request->username, {}, sender, send_response);
+        });
+    };
+    
+    switch (admission->request(sender, start, notify, refuse)) {
+        case login::LoginAdmission::Decision::STARTED:
+            break;
+        case login::LoginAdmission::Decision::QUEUED:
+            LOG_INFO_F("Login for '{}' queued", request->username);
+            break;
+        case login::LoginAdmission::Decision::FULL:
+            LOG_WARNING_F("Login for '{}' refused - server full", request->username);
+            throttle->release(request->username, sender.address());
+            send_login_result(LoginResult::SERVER_FULL, 0, request->username, {}, sender, send_response);
+            break;
+    }
+}
+
+// Inbound SWG messages by opcode
+using SwgHandler = void (*)(const PacketContext&);
+
+constexpr auto SWG_ROUTES = make_opcode_router<SwgHandler>(
+    OpcodeRoute<SwgHandler>{opcode("LoginClientId"), &handle_login_client_id}
+);
+
 // Enhanced packet handler
 void handle_packet(const std::vector<u8>& data, 
                   const boost::asio::ip::udp::endpoint& sender,
-                  std::function<void(const std::vector<u8>&, const boost::asio::ip::udp::endpoint&)> send_response) {
+                  SendFunction send_response,
+                  boost::asio::io_context::executor_type executor) {
     
     LOG_INFO("========================================");
     
@@ -184,12 +393,17 @@ void handle_packet(const std::vector<u8>& data,
                     
                     LOG_INFO("=== Sending Session Response ===");
                     std::vector<u8> response = create_session_response(conn_id);
-                    send_response(response, sender);
+                    send_response(response, sender, SendPriority::RELIABLE_CONTROL);
                     LOG_INFO("SOE session established successfully!");
                 }
                 break;
             }
                 
+            case 0x0400: // Disconnect
+                LOG_INFO("=== Disconnect ===");
+                admission->disconnected(sender);
+                break;
+                
             case 0x0500: // Ping
                 LOG_INFO("=== Ping Packet ===");
                 LOG_INFO("Client sending keep-alive ping");
@@ -200,76 +414,25 @@ void handle_packet(const std::vector<u8>& data,
                 LOG_INFO("Client reporting network status");
                 break;
                 
-            case 0x0900: { // Data Fragment - LOGIN ATTEMPT
+            case 0x0900: { // Data Fragment - SWG message
                 LOG_INFO("=== Data Fragment Packet ===");
-                LOG_INFO("Processing SWG login attempt...");
+                LOG_INFO("Routing SWG message...");
+                
+                u32 swg_opcode = data.size() > 4 ? swg_opcode_of(data.data() + 4, data.size() - 4) : 0;
+                if (data.size() > 4) {
+                    TrafficStats::instance().record_swg_in(swg_opcode, data.size() - 4);
+                }
                 
                 // First, do manual analysis
                 debug_login_packet(data);
                 
-                try {
-                    // Parse login request with fixed offset
-                    login::LoginRequest login_req = 
-                        login::SWGLoginProtocol::parse_login_request(data);
-                    
-                    LOG_INFO("=== Login Request Details ===");
-                    LOG_INFO_F("  Username: '{}'", login_req.username);
-                    LOG_INFO_F("  Password: '{}'", login_req.password);
-                    LOG_INFO_F("  Client Version: '{}'", login_req.client_version);
-                    
-                    // Only proceed if we got a valid username
-                    if (!login_req.username.empty()) {
-                        // Authenticate with account manager
-                        AccountManager& account_mgr = AccountManager::instance();
-                        LoginResult result = account_mgr.authenticate(login_req.username, login_req.password);
-                        
-                        LOG_INFO("=== Authentication Result ===");
-                        switch (result) {
-                            case LoginResult::SUCCESS:
-                                LOG_INFO("Login successful!");
-                                break;
-                            case LoginResult::INVALID_CREDENTIALS:
-                                LOG_INFO("Login failed - invalid credentials");
-                                break;
-                            case LoginResult::ACCOUNT_DISABLED:
-                                LOG_INFO("Login failed - account disabled");
-                                break;
-                            default:
-                                LOG_INFO("Login failed - unknown error");
-                                break;
-                        }
-                        
-                        // Get account ID if successful
-                        u32 account_id = 0;
-                        if (result == LoginResult::SUCCESS) {
-                            auto account = account_mgr.get_account(login_req.username);
-                            if (account) {
-                                account_id = account->account_id;
-                            }
-                        }
-                        
-                        // Create and send login response
-                        LOG_INFO("=== Sending Login Response ===");
-                        std::vector<u8> login_response = 
-                            login::SWGLoginProtocol::create_login_response(result, account_id);
-                        
-                        std::vector<u8> soe_response = 
-                            login::SWGLoginProtocol::wrap_in_soe_data(login_response, 1);
-                        
-                        send_response(soe_response, sender);
-                        LOG_INFO("Login response sent to client!");
-                        
-                        // If successful, client should proceed to server list
-                        if (result == LoginResult::SUCCESS) {
-                            LOG_INFO("Client should now request server list!");
-                        }
-                        
-                    } else {
-                        LOG_WARNING("Skipping authentication - username is empty (parsing failed)");
-                    }
-                    
-                } catch (const std::exception& e) {
-                    LOG_ERROR_F("Error processing login: {}", e.what());
+                if (SwgHandler handler = SWG_ROUTES.find(swg_opcode)) {
+                    handler(PacketContext{data, sender, send_response, executor});
+                } else {
+                    std::ostringstream unhandled;
+                    unhandled << "Unhandled SWG message 0x" << std::hex << std::uppercase
+                              << std::setfill('0') << std::setw(8) << swg_opcode;
+                    LOG_WARNING(unhandled.str());
                 }
                 break;
             }
@@ -287,6 +450,7 @@ void handle_packet(const std::vector<u8>& data,
 int main() {
     std::signal(SIGINT, signal_handler);
     std::signal(SIGTERM, signal_handler);
+    std::signal(SIGUSR1, traffic_signal_handler);  // Dump bandwidth accounting
     
     init_logger(LogLevel::DEBUG_LEVEL);
     
@@ -303,27 +467,242 @@ int main() {
     
     // Initialize account manager
     AccountManager& account_mgr = AccountManager::instance();
-    account_mgr.create_test_accounts();
-    LOG_INFO_F("Loaded {} test accounts", account_mgr.get_account_count());
+    // docker-compose hands the database to the server this way
+    if (const char* url = std::getenv("DATABASE_URL")) {
+        config.set("database_url", url);
+    }
+    // Shared with the zone servers, which verify the tokens this one signs
+    if (const char* key = std::getenv("SESSION_TOKEN_KEY")) {
+        config.set("session_token_key", key);
+    }
+    std::string database_url = config.get("database_url");
+    
+    // Load the token key now so a missing one is reported at startup. With
+    // a database there are zone servers to verify tokens, and a random key
+    // would make every one of them reject this server's logins.
+    if (!SessionTokens::instance().has_configured_key() && !database_url.empty()) {
+        LOG_FATAL("SESSION_TOKEN_KEY (hex, >= 32 bytes) is required when database_url is set");
+        return 1;
+    }
+    
+    if (database_url.empty()) {
+        account_mgr.create_test_accounts();
+        LOG_INFO_F("Loaded {} test accounts", account_mgr.get_account_count());
+    } else {
+#ifdef SWGANH_WITH_POSTGRES
+        try {
+            account_mgr.set_store(std::make_shared<PostgresAccountStore>(
+                database_url, static_cast<u32>(config.get_int("database_pool_size", 10)),
+                std::chrono::seconds(config.get_int("database_connection_timeout", 30))));
+        } catch (const AccountStoreError& e) {
+            LOG_FATAL_F("{}", e.what());
+            return 1;
+        }
+#else
+        LOG_FATAL("database_url is set but this build has no PostgreSQL support");
+        return 1;
+#endif
+    }
+    
+    // With a snapshot, logins are served from it at once; the changes since,
+    // and the filter, come in the background once the workers run
+    std::string snapshot_path = database_url.empty() ? "" : config.get("account_snapshot_path");
+    bool have_snapshot = !snapshot_path.empty() && account_mgr.load_snapshot(snapshot_path);
+    
+    // Unknown names are rejected without a lookup from here on
+    if (!have_snapshot) {
+        account_mgr.rebuild_username_filter();
+    }
+    
+    // Register the cache for character events before any character exists
+    login::CharacterListCache::instance();
+    if (auto test_account = account_mgr.get_account("test")) {
+        CharacterManager::instance().create_test_characters(test_account->account_id);
+    }
     
     try {
-        UdpServer server(44453);
+        u32 network_workers = static_cast<u32>(config.get_int("network_workers", 1));
+        UdpServer server(44453, network_workers);
         
-        server.set_packet_handler([](const std::vector<u8>& data, 
-                                    const boost::asio::ip::udp::endpoint& sender,
-                                    std::function<void(const std::vector<u8>&, const boost::asio::ip::udp::endpoint&)> send_func) {
-            handle_packet(data, sender, send_func);
+        // Authentication is bcrypt-bound: give it whatever cores the IO
+        // workers leave, so a login storm saturates the auth queue (and gets
+        // SERVER_FULL) instead of taking CPU from the network
+        u32 auth_threads = static_cast<u32>(config.get_int("auth_workers", 2));
+        u32 cores = std::thread::hardware_concurrency();
+        if (cores > 0) {
+            u32 spare_cores = cores > network_workers ? cores - network_workers : 1;
+            if (auth_threads > spare_cores) {
+                LOG_WARNING_F("auth_workers {} capped to {} (cores not used by network workers)",
+                              auth_threads, spare_cores);
+                auth_threads = spare_cores;
+            }
+        }
+        WorkerPool auth_workers("Auth", auth_threads,
+                                static_cast<size_t>(config.get_int("auth_queue_capacity", 256)));
+        auth_pool = &auth_workers;
+        auth_workers.start();
+        
+        // Table scans (catch-up, filter rebuilds, snapshot writes) take seconds to minutes at
+        // production sizes; they get their own thread so they never hold a
+        // bcrypt worker or show up in the auth pool's service times
+        WorkerPool maintenance_workers("Maintenance", 1, 4);
+        maintenance_workers.start();
+        auto run_maintenance = [&maintenance_workers](const char* what, WorkerPool::Task task) {
+            if (!maintenance_workers.try_submit(std::move(task))) {
+                LOG_WARNING_F("Account {} skipped - maintenance queue full", what);
+            }
+        };
+        
+        auto snapshot_interval = std::chrono::seconds(config.get_int("account_snapshot_interval", 3600));
+        if (!snapshot_path.empty()) {
+            // A missing or stale snapshot is rewritten now so the next start is fast
+            i64 snapshot_age = std::chrono::duration_cast<std::chrono::seconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count() - account_mgr.snapshot_as_of();
+            bool rewrite = !have_snapshot ||
+                           (snapshot_interval.count() > 0 && snapshot_age >= snapshot_interval.count());
+            run_maintenance("snapshot catch-up", [have_snapshot, rewrite, snapshot_path]() {
+                AccountManager& accounts = AccountManager::instance();
+                if (have_snapshot && accounts.catch_up()) accounts.rebuild_username_filter();
+                if (rewrite) accounts.write_snapshot(snapshot_path);
+            });
+        }
+        
+        login::AdmissionLimits limits;
+        limits.max_concurrent = static_cast<u32>(config.get_int("login_max_concurrent", 32));
+        limits.max_queued = static_cast<u32>(config.get_int("login_queue_size", 500));
+        limits.max_connections = static_cast<u32>(config.get_int("max_connections", 1000));
+        limits.session_timeout = std::chrono::seconds(config.get_int("login_session_timeout", 300));
+        login::LoginAdmission login_admission(limits);
+        admission = &login_admission;
+        
+        login::ThrottleLimits throttle_limits;
+        throttle_limits.max_per_username = static_cast<u32>(config.get_int("max_login_attempts", 5));
+        throttle_limits.max_per_address = static_cast<u32>(config.get_int("max_login_attempts_per_ip", 20));
+        throttle_limits.window = std::chrono::seconds(config.get_int("login_attempt_window", 300));
+        login::LoginThrottle login_throttle(throttle_limits);
+        throttle = &login_throttle;
+        
+        server.set_packet_handler([&server](const std::vector<u8>& data, 
+                                            const boost::asio::ip::udp::endpoint& sender,
+                                            SendFunction send_func) {
+            handle_packet(data, sender, send_func, server.executor_for(sender));
         });
         
+        if (config.get_bool("busy_poll")) {
+            server.set_busy_poll(true,
+                                 static_cast<u32>(config.get_int("busy_poll_usec", 50)),
+                                 config.get_int("busy_poll_cpu", -1));
+        }
+        server.set_latency_tracking(config.get_bool("latency_tracking"));
+        
+        if (!config.get("xdp_interface").empty()) {
+            server.set_xdp_backend(config.get("xdp_interface"));
+        }
+        
         server.start();
         LOG_INFO("Login server started with FIXED parsing!");
         LOG_INFO("Try connecting with username 'test' and password 'test'");
         
+        // Live population from the zone processes; while none has published
+        // recently, the server list shows its defaults
+        GalaxyStatusFeed galaxy_status;
+        u32 galaxy_id = static_cast<u32>(config.get_int("galaxy_id", 1));
+        u64 galaxy_status_max_age = static_cast<u64>(config.get_int("galaxy_status_max_age_ms", 10000));
+        
+        // Picks up accounts created by other login servers or the website
+        auto filter_refresh = std::chrono::seconds(config.get_int("username_filter_refresh", 300));
+        auto next_filter_refresh = std::chrono::steady_clock::now() + filter_refresh;
+        
+        // Bans and password changes made elsewhere reach this node's memory
+        auto catch_up_interval = std::chrono::seconds(config.get_int("account_catch_up_interval", 60));
+        auto next_catch_up = std::chrono::steady_clock::now() + catch_up_interval;
+        auto next_snapshot = std::chrono::steady_clock::now() + snapshot_interval;
+        
+        auto next_throttle_compact = std::chrono::steady_clock::now();
+        
+        // The per-session traffic table is fixed-size and never evicts, so
+        // endpoints that went away are dropped on an interval and after dumps
+        auto traffic_session_reset = std::chrono::seconds(config.get_int("traffic_session_reset", 300));
+        auto next_traffic_session_reset = std::chrono::steady_clock::now() + traffic_session_reset;
+        
+        auto next_tick = std::chrono::steady_clock::now();
         while (running) {
             std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            
+            // Queue positions and session expiry, once a second
+            if (std::chrono::steady_clock::now() >= next_tick) {
+                login_admission.tick();
+                if (!galaxy_status.is_open()) {
+                    galaxy_status.open_reader(config.get("galaxy_status_shm"));
+                }
+                next_tick += std::chrono::seconds(1);
+                
+                // Keys idle for two windows are all that compaction removes
+                if (std::chrono::steady_clock::now() >= next_throttle_compact) {
+                    login_throttle.compact();
+                    next_throttle_compact += std::chrono::seconds(30);
+                }
+                
+                if (!database_url.empty() && filter_refresh.count() > 0 &&
+                    std::chrono::steady_clock::now() >= next_filter_refresh) {
+                    run_maintenance("username filter rebuild",
+                                    []() { AccountManager::instance().rebuild_username_filter(); });
+                    next_filter_refresh += filter_refresh;
+                }
+                
+                if (!database_url.empty() && catch_up_interval.count() > 0 &&
+                    std::chrono::steady_clock::now() >= next_catch_up) {
+                    run_maintenance("catch-up", []() { AccountManager::instance().catch_up(); });
+                    next_catch_up += catch_up_interval;
+                }
+                
+                if (!snapshot_path.empty() && snapshot_interval.count() > 0 &&
+                    std::chrono::steady_clock::now() >= next_snapshot) {
+                    run_maintenance("snapshot write", [snapshot_path]() {
+                        AccountManager::instance().write_snapshot(snapshot_path);
+                    });
+                    next_snapshot += snapshot_interval;
+                }
+            }
+            
+            // Plain loads from shared memory; the list is re-encoded only on change
+            GalaxyLoad load = galaxy_status.read(galaxy_id, galaxy_status_max_age);
+            if (load.zones > 0) {
+                login::ServerListCache::instance().set_population(load.population, load.max_population);
+            } else {
+                // The last zone went quiet; do not keep advertising its figures
+                login::ServerListCache::instance().reset_population();
+            }
+            
+            if (dump_traffic) {
+                dump_traffic = false;
+                LOG_INFO("Traffic: " + TrafficStats::instance().snapshot().to_json());
+                server.log_stats();
+                auth_workers.log_stats();
+                maintenance_workers.log_stats();
+                login_admission.log_stats();
+                login_throttle.log_stats();
+                login::CharacterListCache::instance().log_stats();
+                AccountManager::instance().log_stats();
+                
+                // Each dump covers the sessions seen since the previous one
+                TrafficStats::instance().reset_sessions();
+                next_traffic_session_reset = std::chrono::steady_clock::now() + traffic_session_reset;
+            } else if (traffic_session_reset.count() > 0 &&
+                       std::chrono::steady_clock::now() >= next_traffic_session_reset) {
+                TrafficStats::instance().reset_sessions();
+                next_traffic_session_reset = std::chrono::steady_clock::now() + traffic_session_reset;
+            }
         }
         
+        // Finish accepted logins while the workers can still send the replies
+        auth_workers.stop();
+        maintenance_workers.stop();
+        account_mgr.flush_login_stats();
         server.stop();
+        auth_pool = nullptr;
+        admission = nullptr;
+        throttle = nullptr;
         
     } catch (const std::exception& e) {
         std::ostringstream error_msg;
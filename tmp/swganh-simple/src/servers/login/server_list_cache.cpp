@@ -0,0 +1,59 @@
+// File: src/servers/login/server_list_cache.cpp
+#include "server_list_cache.hpp"
+#include "swg_protocol.hpp"
+#include "../../core/config.hpp"
+#include "../../core/logger.hpp"
+
+namespace swganh {
+namespace login {
+
+std::shared_ptr<const ServerList> ServerListCache::get() {
+    std::shared_ptr<const Snapshot> snapshot = current_.load(std::memory_order_acquire);
+    
+    if (!snapshot || snapshot->config_generation != Config::instance().generation()) {
+        snapshot = snapshot ? rebuild(snapshot->population, snapshot->max_population)
+                            : rebuild(DEFAULT_POPULATION, DEFAULT_MAX_POPULATION);
+    }
+    
+    // Aliasing constructor: shares ownership of the snapshot, points at its messages
+    return std::shared_ptr<const ServerList>(snapshot, &snapshot->messages);
+}
+
+void ServerListCache::set_population(u32 population, u32 max_population) {
+    std::shared_ptr<const Snapshot> snapshot = current_.load(std::memory_order_acquire);
+    if (snapshot && snapshot->population == population && snapshot->max_population == max_population &&
+        snapshot->config_generation == Config::instance().generation()) {
+        return;
+    }
+    
+    rebuild(population, max_population);
+}
+
+std::shared_ptr<const ServerListCache::Snapshot> ServerListCache::rebuild(u32 population, u32 max_population) {
+    std::lock_guard<std::mutex> lock(rebuild_mutex_);
+    
+    // Read the generation before the values so a concurrent set() forces another rebuild
+    u64 generation = Config::instance().generation();
+    
+    // Another thread may have rebuilt while we waited for the lock
+    std::shared_ptr<const Snapshot> existing = current_.load(std::memory_order_acquire);
+    if (existing && existing->config_generation == generation &&
+        existing->population == population && existing->max_population == max_population) {
+        return existing;
+    }
+    
+    auto snapshot = std::make_shared<Snapshot>(Snapshot{
+        generation, population, max_population,
+        ServerList{SWGLoginProtocol::create_enum_cluster(),
+                   SWGLoginProtocol::create_cluster_status(population, max_population)}
+    });
+    
+    current_.store(snapshot, std::memory_order_release);
+    LOG_DEBUG_F("Server list rebuilt ({} bytes, population {}/{})",
+                snapshot->messages.enum_cluster.size() + snapshot->messages.cluster_status.size(),
+                population, max_population);
+    return snapshot;
+}
+
+} // namespace login
+} // namespace swganh
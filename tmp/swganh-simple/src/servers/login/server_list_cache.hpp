@@ -0,0 +1,58 @@
+// File: src/servers/login/server_list_cache.hpp
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "../../core/types.hpp"
+
+namespace swganh {
+namespace login {
+
+// Serialized SWG messages (unwrapped) sent after a successful login
+struct ServerList {
+    std::vector<u8> enum_cluster;    // LoginEnumCluster
+    std::vector<u8> cluster_status;  // LoginClusterStatus
+};
+
+// The galaxy list is identical for every client, so it is serialized once
+// into an immutable buffer that all responses share. The buffer is swapped
+// atomically when the population changes or when Config reports a new
+// generation (server name, status, ...); readers never block or re-encode.
+class ServerListCache {
+public:
+    static ServerListCache& instance() {
+        static ServerListCache inst;
+        return inst;
+    }
+    
+    // Current serialized server list
+    std::shared_ptr<const ServerList> get();
+    
+    // Shown until a zone publishes, and again once none does
+    static constexpr u32 DEFAULT_POPULATION = 100;
+    static constexpr u32 DEFAULT_MAX_POPULATION = 3000;
+    
+    // Publish new population figures; rebuilds only if they changed
+    void set_population(u32 population, u32 max_population);
+    void reset_population() { set_population(DEFAULT_POPULATION, DEFAULT_MAX_POPULATION); }
+
+private:
+    struct Snapshot {
+        u64 config_generation;
+        u32 population;
+        u32 max_population;
+        ServerList messages;
+    };
+    
+    ServerListCache() = default;
+    
+    std::shared_ptr<const Snapshot> rebuild(u32 population, u32 max_population);
+    
+    std::atomic<std::shared_ptr<const Snapshot>> current_;
+    std::mutex rebuild_mutex_;  // Writers only
+};
+
+} // namespace login
+} // namespace swganh
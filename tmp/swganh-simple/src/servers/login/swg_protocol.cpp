@@ -2,85 +2,109 @@
 #include "swg_protocol.hpp"
 #include "../../core/logger.hpp"
 #include "../../core/config.hpp"
+#include "login_messages.hpp"
 
 namespace swganh {
 namespace login {
 
-LoginRequest SWGLoginProtocol::parse_login_request(const std::vector<u8>& data) {
-    LoginRequest request;
-    
-    LOG_DEBUG("=== Parsing Login Request ===");
-    LOG_DEBUG_F("Total packet size: {} bytes", data.size());
-    
-    size_t offset = 10; // Skip SOE header (4 bytes) + SWG header (6 bytes)
-    
-    LOG_DEBUG_F("Starting string parsing at offset: {}", offset);
-    
-    // Read username
-    request.username = read_string(data, offset);
-    LOG_DEBUG_F("Parsed username: '{}' (offset now: {})", request.username, offset);
-    
-    // Read password  
-    request.password = read_string(data, offset);
-    LOG_DEBUG_F("Parsed password: '{}' (offset now: {})", request.password, offset);
-    
-    // Read client version
-    request.client_version = read_string(data, offset);
-    LOG_DEBUG_F("Parsed client version: '{}' (offset now: {})", request.client_version, offset);
+bool SWGLoginProtocol::parse_login_request_view(const u8* data, size_t size, LoginRequestView& out) {
+    // SOE data header (opcode + sequence), then the whole SWG message, whose
+    // operand count and opcode are checked rather than skipped
+    constexpr size_t SOE_HEADER_SIZE = 4;
+    if (size < SOE_HEADER_SIZE) return false;
+    
+    messages::LoginClientId::Values fields;
+    if (!messages::LoginClientId::decode(data + SOE_HEADER_SIZE, size - SOE_HEADER_SIZE, fields)) return false;
+    
+    auto& [username, password, client_version] = fields;
+    if (username.size() > MAX_LOGIN_STRING || password.size() > MAX_LOGIN_STRING ||
+        client_version.size() > MAX_LOGIN_STRING) {
+        return false;
+    }
     
-    return request;
+    out.username = username;
+    out.password = password;
+    out.client_version = client_version;
+    return true;
 }
 
-std::vector<u8> SWGLoginProtocol::create_login_response(LoginResult result, u32 account_id) {
-    std::vector<u8> response;
-    
-    LOG_INFO("=== Creating SIMPLE Error Response for Testing ===");
-    
-    // Try a very simple response format - just operand count and error code
-    // This should at least get the client to react differently if our format is working
-    
-    // Write operand count (1 = just the result code)
-    write_u16_le(response, 1);
-    
-    // Use a simple error opcode that might be recognized
-    // Let's try using the same opcode as the request but with a simple modification
-    write_u32_le(response, 0x411396C5); // Request was 0x411396C4, try +1
-    
-    // Write error result code (1 = failure)
-    write_u32_le(response, 1); // Always send failure for now to test
+LoginRequest SWGLoginProtocol::parse_login_request(const std::vector<u8>& data) {
+    LoginRequestView view;
+    if (!parse_login_request_view(data.data(), data.size(), view)) {
+        LOG_WARNING_F("Malformed login request ({} bytes)", data.size());
+        return LoginRequest{};
+    }
+    return view.to_owned();
+}
+
+std::vector<u8> SWGLoginProtocol::create_login_response(LoginResult result, u32 account_id,
+                                                        std::string_view username,
+                                                        std::span<const u8> session_token) {
+    if (result == LoginResult::SUCCESS) {
+        return messages::LoginClientToken::encode({session_token, account_id, username});
+    }
     
-    LOG_INFO_F("Created simple error response ({} bytes)", response.size());
+    std::string_view description;
+    switch (result) {
+        case LoginResult::INVALID_CREDENTIALS: description = "Invalid username or password."; break;
+        case LoginResult::ACCOUNT_DISABLED:    description = "This account has been disabled."; break;
+        case LoginResult::SERVER_FULL:         description = "The server is full. Please try again later."; break;
+        case LoginResult::MAINTENANCE:         description = "The server is down for maintenance."; break;
+        default:                               description = "Login failed."; break;
+    }
     
-    return response;
+    return messages::ErrorMessage::encode({"@cpt_login_fail", description, 0});
+}
+
+std::vector<u8> SWGLoginProtocol::create_queue_position(u32 position) {
+    std::string text = "The server is busy. You are number " + std::to_string(position) +
+                       " in the login queue.";
+    return messages::ErrorMessage::encode({"@cpt_login_queue", text, 0});
 }
 
-std::vector<u8> SWGLoginProtocol::create_server_list_response() {
-    std::vector<u8> response;
+std::vector<u8> SWGLoginProtocol::create_enum_cluster() {
     Config& config = Config::instance();
+    std::string name = config.get("server_name");
     
-    // Operand count for server list: count + server_data
-    write_u16_le(response, 2);
+    // One galaxy for now
+    messages::LoginEnumCluster::Values values;
+    std::get<0>(values).emplace_back(1, name, 0);
+    std::get<1>(values) = static_cast<u32>(config.get_int("max_characters_per_account", 2));
     
-    // Server List Response opcode
-    write_u32_le(response, static_cast<u32>(SWGOpcode::SERVER_LIST_RESPONSE));
+    return messages::LoginEnumCluster::encode(values);
+}
+
+std::vector<u8> SWGLoginProtocol::create_cluster_status(u32 population, u32 max_population) {
+    Config& config = Config::instance();
+    u32 max_characters = static_cast<u32>(config.get_int("max_characters_per_account", 2));
     
-    // Number of servers (1 for now)
-    write_u32_le(response, 1);
+    // Galaxy 1 is the zone server on 44464 (ping on 44462), status 2 = online
+    messages::LoginClusterStatus::Values values;
+    std::get<0>(values).emplace_back(1, "127.0.0.1", 44464, 44462, static_cast<i32>(population),
+                                     max_population, max_characters, 0, 2, 0);
     
-    // Server info
-    write_u32_le(response, 1); // Server ID
-    write_string(response, config.get("server_name"));
-    write_string(response, config.get("server_population"));
-    write_u32_le(response, 100); // Current population
-    write_u32_le(response, 3000); // Max population
-    write_string(response, "127.0.0.1"); // Server address
-    write_u16_le(response, 44464); // Zone server port
+    return messages::LoginClusterStatus::encode(values);
+}
+
+std::vector<u8> SWGLoginProtocol::create_enumerate_character_id(const std::vector<Character>& characters) {
+    u32 galaxy_id = static_cast<u32>(Config::instance().get_int("galaxy_id", 1));
+    
+    // Species goes out as the CRC of its template path, the same hash as opcodes;
+    // names are ASCII, widened to UTF-16. Status 1 = normal.
+    messages::EnumerateCharacterId::Values values;
+    auto& list = std::get<0>(values);
+    list.reserve(characters.size());
+    for (const Character& character : characters) {
+        list.emplace_back(std::u16string(character.name.begin(), character.name.end()),
+                          opcode(character.species), character.character_id, galaxy_id, 1);
+    }
     
-    return response;
+    return messages::EnumerateCharacterId::encode(values);
 }
 
 std::vector<u8> SWGLoginProtocol::wrap_in_soe_data(const std::vector<u8>& swg_message, u16 sequence) {
     std::vector<u8> soe_packet;
+    soe_packet.reserve(4 + swg_message.size() + 2);
     
     // SOE Data packet (0x0800) for responses
     soe_packet.push_back(0x00);
@@ -102,60 +126,5 @@ std::vector<u8> SWGLoginProtocol::wrap_in_soe_data(const std::vector<u8>& swg_me
     return soe_packet;
 }
 
-std::string SWGLoginProtocol::read_string(const std::vector<u8>& data, size_t& offset) {
-    if (offset + 2 > data.size()) {
-        LOG_WARNING_F("Cannot read string length at offset {} (data size: {})", offset, data.size());
-        return "";
-    }
-    
-    // Read length (little-endian)
-    u16 length = data[offset] | (data[offset + 1] << 8);
-    LOG_DEBUG_F("Reading string at offset {}: length = {}", offset, length);
-    offset += 2;
-    
-    if (length == 0) {
-        LOG_DEBUG("String length is 0, returning empty string");
-        return "";
-    }
-    
-    if (length > 1000) {  // Sanity check
-        LOG_WARNING_F("String length {} seems unreasonable, returning empty string", length);
-        return "";
-    }
-    
-    if (offset + length > data.size()) {
-        LOG_WARNING_F("String length {} extends beyond data size at offset {} (data size: {})", 
-                     length, offset, data.size());
-        return "";
-    }
-    
-    // Read string data
-    std::string result(data.begin() + offset, data.begin() + offset + length);
-    offset += length;
-    
-    LOG_DEBUG_F("Read string: '{}' (new offset: {})", result, offset);
-    return result;
-}
-
-void SWGLoginProtocol::write_u32_le(std::vector<u8>& data, u32 value) {
-    data.push_back(value & 0xFF);
-    data.push_back((value >> 8) & 0xFF);
-    data.push_back((value >> 16) & 0xFF);
-    data.push_back((value >> 24) & 0xFF);
-}
-
-void SWGLoginProtocol::write_u16_le(std::vector<u8>& data, u16 value) {
-    data.push_back(value & 0xFF);
-    data.push_back((value >> 8) & 0xFF);
-}
-
-void SWGLoginProtocol::write_string(std::vector<u8>& data, const std::string& str) {
-    // Write length first (little-endian)
-    write_u16_le(data, static_cast<u16>(str.length()));
-    
-    // Write string data
-    data.insert(data.end(), str.begin(), str.end());
-}
-
 } // namespace login
 } // namespace swganh
\ No newline at end of file
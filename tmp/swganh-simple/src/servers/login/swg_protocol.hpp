@@ -1,25 +1,25 @@
 // File: src/servers/login/swg_protocol.hpp
 #pragma once
 
+#include <span>
 #include <vector>
 #include <string>
+#include <string_view>
 #include "../../core/types.hpp"
 #include "../../core/account_manager.hpp"
+#include "../../core/character_manager.hpp"
+#include "../../network/swg_opcode.hpp"
 
 namespace swganh {
 namespace login {
 
-// SWG Login Protocol Message IDs (corrected based on SWGANH research)
+// SWG login message opcodes, derived from the message names
 enum class SWGOpcode : u32 {
-    // These are commonly seen opcodes from SWG protocol research
-    LOGIN_REQUEST     = 0x41139C04,  // Observed in packet: 04 00 96 1F 13 41 = 0x411396C4
-    LOGIN_RESPONSE    = 0x3436AEB6,  // Standard login response (needs verification)
-    SERVER_LIST_REQUEST = 0x04778A75,
-    SERVER_LIST_RESPONSE = 0x3C2EF2F4,
-    
-    // Alternative opcodes based on wiki patterns
-    LOGIN_RESPONSE_ALT = 0xB6AE3634,  // Byte-swapped version
-    ERROR_MESSAGE      = 0x00000000   // Generic error
+    LOGIN_CLIENT_ID      = opcode("LoginClientId"),
+    LOGIN_CLIENT_TOKEN   = opcode("LoginClientToken"),
+    LOGIN_ENUM_CLUSTER   = opcode("LoginEnumCluster"),
+    LOGIN_CLUSTER_STATUS = opcode("LoginClusterStatus"),
+    ERROR_MESSAGE        = opcode("ErrorMessage")
 };
 
 struct LoginRequest {
@@ -28,6 +28,18 @@ struct LoginRequest {
     std::string client_version;
 };
 
+// Zero-copy LoginClientId: fields borrow from the receive buffer and are only
+// valid while it is. Call to_owned() when the strings must outlive it.
+struct LoginRequestView {
+    std::string_view username;
+    std::string_view password;
+    std::string_view client_version;
+    
+    LoginRequest to_owned() const {
+        return LoginRequest{std::string(username), std::string(password), std::string(client_version)};
+    }
+};
+
 struct ServerInfo {
     u32 server_id;
     std::string name;
@@ -40,24 +52,38 @@ struct ServerInfo {
 
 class SWGLoginProtocol {
 public:
-    // Parse login request from data fragment
+    // Longest string accepted in a login request
+    static constexpr u16 MAX_LOGIN_STRING = 1000;
+    
+    // Parse login request from data fragment into borrowed fields. Validates
+    // every length in one pass; returns false (with out untouched) on
+    // malformed input. Does not log.
+    static bool parse_login_request_view(const u8* data, size_t size, LoginRequestView& out);
+    
+    // Owning variant; fields are empty when the packet is malformed
     static LoginRequest parse_login_request(const std::vector<u8>& data);
     
-    // Create login response packet (wiki-compliant format)
-    static std::vector<u8> create_login_response(LoginResult result, u32 account_id = 0);
+    // LoginClientToken carrying the signed session token on success,
+    // ErrorMessage otherwise
+    static std::vector<u8> create_login_response(LoginResult result, u32 account_id = 0,
+                                                 std::string_view username = {},
+                                                 std::span<const u8> session_token = {});
+    
+    // Non-fatal ErrorMessage telling a waiting client its place in the login queue
+    static std::vector<u8> create_queue_position(u32 position);
     
-    // Create server list response
-    static std::vector<u8> create_server_list_response();
+    // Galaxy list (LoginEnumCluster) and galaxy status (LoginClusterStatus).
+    // Prefer ServerListCache, which builds these once and shares the bytes
+    // between clients.
+    static std::vector<u8> create_enum_cluster();
+    static std::vector<u8> create_cluster_status(u32 population = 100, u32 max_population = 3000);
+    
+    // Character selection list (EnumerateCharacterId). Prefer
+    // CharacterListCache, which keeps the bytes per account.
+    static std::vector<u8> create_enumerate_character_id(const std::vector<Character>& characters);
     
     // Wrap SWG message in SOE data packet (with CRC)
     static std::vector<u8> wrap_in_soe_data(const std::vector<u8>& swg_message, u16 sequence = 0);
-
-private:
-    // Helper functions for reading/writing data
-    static std::string read_string(const std::vector<u8>& data, size_t& offset);
-    static void write_u32_le(std::vector<u8>& data, u32 value);
-    static void write_u16_le(std::vector<u8>& data, u16 value);
-    static void write_string(std::vector<u8>& data, const std::string& str);
 };
 
 } // namespace login
@@ -0,0 +1,53 @@
+// File: src/tools/galaxy_status_publisher.cpp
+// Publishes a zone's population to the galaxy status feed once a second,
+// the way a zone server would, so the login server can be exercised alone.
+//
+//   galaxy_status_publisher <population> [max_population] [galaxy_id]
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <thread>
+
+#include "../core/logger.hpp"
+#include "../core/config.hpp"
+#include "../core/galaxy_status_feed.hpp"
+
+using namespace swganh;
+
+volatile bool running = true;
+
+void signal_handler(int) {
+    running = false;
+}
+
+int main(int argc, char* argv[]) {
+    std::signal(SIGINT, signal_handler);
+    std::signal(SIGTERM, signal_handler);
+
+    init_logger(LogLevel::INFO_LEVEL);
+
+    if (argc < 2) {
+        LOG_ERROR("Usage: galaxy_status_publisher <population> [max_population] [galaxy_id]");
+        return 1;
+    }
+
+    Config& config = Config::instance();
+    u32 population = static_cast<u32>(std::strtoul(argv[1], nullptr, 10));
+    u32 max_population = argc > 2 ? static_cast<u32>(std::strtoul(argv[2], nullptr, 10)) : 3000;
+    u32 galaxy_id = argc > 3 ? static_cast<u32>(std::strtoul(argv[3], nullptr, 10))
+                             : static_cast<u32>(config.get_int("galaxy_id", 1));
+
+    GalaxyStatusFeed feed;
+    u64 max_age = static_cast<u64>(config.get_int("galaxy_status_max_age_ms", 10000));
+    if (!feed.open_publisher(config.get("galaxy_status_shm"), max_age)) {
+        return 1;
+    }
+
+    LOG_INFO_F("Galaxy {}: publishing population {}/{}", galaxy_id, population, max_population);
+    while (running) {
+        feed.publish(galaxy_id, population, max_population);
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+    }
+
+    return 0;
+}